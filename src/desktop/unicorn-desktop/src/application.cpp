@@ -15,6 +15,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <deque>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -102,6 +103,8 @@ namespace Unicorn {
 #ifdef HAVE_CURL
             m_ApiEndpoint = "https://jsonplaceholder.typicode.com/posts/1";
             m_ApiMethod = Background::RequestMethod::GET;
+            // The HRMS stand-in (tools/hrms_stub) on its default port
+            m_LiveEvents.url = "http://127.0.0.1:5080/api/events/stream?access_token=stub.desktop";
 #endif
         }
 
@@ -189,7 +192,7 @@ namespace Unicorn {
 #ifdef HAVE_CURL
             auto& bgManager = Background::BackgroundManager::Get();
             bgManager.Init();
-            bgManager.SetMaxConcurrentRequests(5);
+            bgManager.SetConcurrencyLimit(5, 2, 64);
             std::cout << "[HRMS] Background API Manager: Enabled" << std::endl;
 #else
             std::cout << "[HRMS] Background API Manager: Disabled" << std::endl;
@@ -225,7 +228,7 @@ namespace Unicorn {
             uint32_t windowWidth = GetWindow().GetWidth();
             uint32_t windowHeight = GetWindow().GetHeight();
 
-            ui.SetScrollPhysics(0.88f, 350.0f, 26.0f);
+            ui.SetScrollPhysics(350.0f);
 
             static int lastSelectedPage = m_SelectedPage;
             bool pageChanged = (m_SelectedPage != lastSelectedPage);
@@ -377,47 +380,69 @@ namespace Unicorn {
 
         void RenderEmployees(UI::UIContext& ui, float contentX, float contentWidth) {
             float windowWidth = glm::min(contentWidth * 0.95f, 900.0f);
+            float panelWidth = windowWidth - 40.0f; // Leave margin for window padding
 
             ui.BeginWindow("الموظفين",
                 glm::vec2(contentX, 30),
-                glm::vec2(windowWidth, 600)
+                glm::vec2(windowWidth, 760)
             );
 
+            // Arabic page: RTL stacks put everything against the right edge,
+            // so nothing below is positioned by hand
+            UI::StackStyle page;
+            page.direction = UI::LayoutDirection::RTL;
+
+            ui.BeginStack("employees_header", UI::StackAxis::Vertical, glm::vec2(panelWidth, 0.0f), page);
             ui.TextColored(UI::Color::Primary, "إدارة الموظفين");
+            ui.EndStack();
+
             ui.Spacing();
-            ui.Separator(1.0f, windowWidth - 40.0f);
+            ui.Separator(1.0f, panelWidth);
             ui.Spacing();
 
-            float buttonWidth = glm::min(windowWidth - 40.0f, 250.0f);
+            ui.BeginStack("employees_actions", UI::StackAxis::Horizontal, glm::vec2(panelWidth, 0.0f), page);
+            float buttonWidth = glm::min(panelWidth, 250.0f);
             if (ui.ButtonWithIcon("person", "إضافة موظف جديد", glm::vec2(buttonWidth, 42))) {
                 std::cout << "Add employee clicked" << std::endl;
             }
+            ui.EndStack();
 
             ui.Spacing();
-            ui.Separator(1.0f, windowWidth - 40.0f);
+            ui.Separator(1.0f, panelWidth);
             ui.Spacing();
 
+            ui.BeginStack("employees_list", UI::StackAxis::Vertical, glm::vec2(panelWidth, 0.0f), page);
             ui.Text("قائمة الموظفين:");
-            ui.Spacing();
-
-            float panelWidth = windowWidth - 40.0f; // Leave margin for window padding
 
             ui.BeginScrollablePanel("employee_list", glm::vec2(panelWidth, 350), UI::BorderStyle::Outset);
             {
 
                 float itemWidth = panelWidth - 30.0f; // Leave space for scrollbar (12px) + padding
 
+                UI::StackStyle row = page;
+                row.spacing = 4.0f;
+
                 for (int i = 0; i < 50; i++) {
                     ui.Panel(glm::vec2(itemWidth, 60), [&]() {
+                        ui.BeginStack("employee_" + std::to_string(i), UI::StackAxis::Vertical,
+                            glm::vec2(itemWidth - 20.0f, 0.0f), row);
                         std::string name = "موظف #" + std::to_string(i + 1);
                         ui.TextColored(UI::Color::Black, name);
                         ui.TextColored(UI::Color::TextSecondary, "الوظيفة: محاسب");
+                        ui.EndStack();
                         });
                     ui.Spacing(5.0f);
                 }
             }
             ui.EndScrollablePanel();
 
+            ui.Text("ملاحظات الموارد البشرية:");
+
+            if (ui.TextEditor("##employee_notes", m_EmployeeNotes, glm::vec2(panelWidth, 130))) {
+                ui.MarkDirty();
+            }
+            ui.EndStack();
+
             ui.EndWindow();
         }
 
@@ -485,6 +510,15 @@ namespace Unicorn {
             ui.Text("Rendering Stats:");
             ui.Text("FPS: " + std::to_string(fpsCounter));
 
+            const auto& frameStats = GetFramePacer().GetStats();
+            ui.Text("Refresh: " + std::to_string(static_cast<int>(frameStats.refreshRate)) + " Hz" +
+                (frameStats.vsync ? " (vsync)" : ""));
+            ui.Text("Target: " + std::to_string(static_cast<int>(frameStats.targetRate)) + " Hz, measured: " +
+                std::to_string(static_cast<int>(frameStats.measuredRate)) + " Hz");
+            ui.Text("Missed frames: " + std::to_string(frameStats.missedFrames) +
+                " / " + std::to_string(frameStats.framesPresented) +
+                " (worst " + std::to_string(static_cast<int>(frameStats.worstIntervalMs)) + " ms)");
+
             ui.Spacing();
             ui.Separator(1.0f, windowWidth - 40.0f);
             ui.Spacing();
@@ -661,6 +695,7 @@ namespace Unicorn {
             options.url = m_ApiEndpoint;
             options.method = m_ApiMethod;
             options.timeoutSeconds = 30;
+            options.priority = Background::RequestPriority::Interactive;
 
             options.headers["Content-Type"] = "application/json";
             options.headers["Accept"] = "application/json";
@@ -695,7 +730,7 @@ namespace Unicorn {
         void OnAPIRequestComplete(Background::RequestState state,
             const Background::Response& response) {
             m_ApiRequestState = state;
-            m_ApiResponseBody = response.body;
+            m_ApiResponseBody = response.body.ToString();
             m_ApiError = response.error;
             m_ApiResponseCode = response.statusCode;
             m_ApiResponseTime = response.elapsedTime;
@@ -739,20 +774,85 @@ namespace Unicorn {
                 std::string avgTime = "Avg Response Time: " +
                     std::to_string(static_cast<int>(stats.averageResponseTime * 1000)) + " ms";
                 ui.Text(avgTime);
+
+                std::string reuse = "Connection Reuse: " +
+                    std::to_string(static_cast<int>(stats.connectionReuseRate * 100.0 + 0.5)) + "%";
+                ui.Text(reuse);
+
+                if (stats.multiplexedRequests > 0) {
+                    ui.Text("Over HTTP/2: " + std::to_string(stats.multiplexedRequests));
+                }
+            }
+
+            if (stats.retries > 0 || stats.hedgedRequests > 0 || stats.shortCircuited > 0) {
+                ui.Text("Retries: " + std::to_string(stats.retries) +
+                    "  Hedged: " + std::to_string(stats.hedgedRequests) +
+                    " (" + std::to_string(stats.hedgeWins) + " won)" +
+                    "  Failed Fast: " + std::to_string(stats.shortCircuited));
+            }
+
+            for (const auto& host : bgManager.GetConcurrencyLimits()) {
+                static const char* decisions[] = { "hold", "raised", "lowered (latency)", "lowered (errors)" };
+                ui.Text("Concurrency " + host.host + ": " + std::to_string(host.inFlight) + " / " +
+                    std::to_string(host.limit) + (host.slowStart && host.adaptive ? " (slow start)" : ""));
+                ui.TextColored(UI::Color::TextSecondary,
+                    "Latency " + std::to_string(static_cast<int>(host.recentLatency * 1000.0 + 0.5)) +
+                    " ms (baseline " + std::to_string(static_cast<int>(host.baselineLatency * 1000.0 + 0.5)) +
+                    " ms)  Raised " + std::to_string(host.increases) +
+                    "  Lowered " + std::to_string(host.latencyDecreases + host.errorDecreases) +
+                    "  Last: " + decisions[static_cast<int>(host.lastDecision)]);
             }
 
             std::string downloaded = "Downloaded: " +
                 std::to_string(stats.totalBytesDownloaded / 1024) + " KB";
+            if (stats.totalBytesDecoded > stats.totalBytesDownloaded) {
+                downloaded += " (" + std::to_string(stats.totalBytesDecoded / 1024) + " KB decoded)";
+            }
             ui.Text(downloaded);
 
             std::string uploaded = "Uploaded: " +
                 std::to_string(stats.totalBytesUploaded / 1024) + " KB";
+            if (stats.totalBytesUploadedRaw > stats.totalBytesUploaded) {
+                uploaded += " (" + std::to_string(stats.totalBytesUploadedRaw / 1024) + " KB before gzip)";
+            }
             ui.Text(uploaded);
 
             ui.Spacing();
             ui.Separator(1.0f, windowWidth - 40.0f);
             ui.Spacing();
 
+            ui.TextColored(UI::Color::Primary, "Latency by Endpoint");
+            ui.Spacing();
+
+            auto endpoints = bgManager.GetEndpointLatencies();
+            if (!endpoints.empty()) {
+                auto ms = [](double seconds) {
+                    return std::to_string(static_cast<int>(seconds * 1000.0 + 0.5));
+                };
+
+                for (size_t i = 0; i < endpoints.size() && i < 8; i++) {
+                    const auto& endpoint = endpoints[i];
+                    ui.Text(endpoint.endpoint + "  (" + std::to_string(endpoint.count) + ")");
+                    ui.TextColored(UI::Color::TextSecondary,
+                        "p50 " + ms(endpoint.p50) + "  p95 " + ms(endpoint.p95) +
+                        "  p99 " + ms(endpoint.p99) + "  max " + ms(endpoint.max) + " ms");
+                    ui.TextColored(UI::Color::TextSecondary,
+                        "DNS " + ms(endpoint.meanTiming.dns) +
+                        "  Connect " + ms(endpoint.meanTiming.connect) +
+                        "  TLS " + ms(endpoint.meanTiming.tls) +
+                        "  Wait " + ms(endpoint.meanTiming.wait) +
+                        "  Download " + ms(endpoint.meanTiming.download) + " ms (avg)");
+                    ui.Spacing(3.0f);
+                }
+            }
+            else {
+                ui.TextColored(UI::Color::TextSecondary, "No network requests yet");
+            }
+
+            ui.Spacing();
+            ui.Separator(1.0f, windowWidth - 40.0f);
+            ui.Spacing();
+
             ui.TextColored(UI::Color::Primary, "Quick Tests");
             ui.Spacing();
 
@@ -782,6 +882,25 @@ namespace Unicorn {
                 TestLargeDownload();
             }
 
+            if (ui.Button("Benchmark HTTP/2 vs HTTP/1.1", glm::vec2(buttonWidth, 40)) && !m_FanOut.running) {
+                BenchmarkFanOut();
+            }
+
+            if (m_FanOut.running) {
+                ui.TextColored(UI::Color::TextSecondary, "Benchmark running (" +
+                    std::string(m_FanOut.phase == 0 ? "HTTP/2" : "HTTP/1.1") + ", " +
+                    std::to_string(m_FanOut.remaining) + " left)");
+            }
+            for (int phase = 0; phase < 2 && m_FanOut.completed > phase; phase++) {
+                ui.Text(FanOutSummary(phase));
+            }
+
+            ui.Spacing();
+            ui.Separator(1.0f, windowWidth - 40.0f);
+            ui.Spacing();
+
+            RenderLiveEvents(ui, windowWidth, buttonWidth);
+
             ui.Spacing();
             ui.Separator(1.0f, windowWidth - 40.0f);
             ui.Spacing();
@@ -796,9 +915,23 @@ namespace Unicorn {
                 ui.BeginScrollablePanel("request_history", glm::vec2(panelWidth, 300),
                     UI::BorderStyle::Inset);
                 {
-                    for (const auto& entry : history) {
-                        ui.Panel(glm::vec2(panelWidth - 20.0f, 50), [&]() {
+                    for (const auto& record : history) {
+                        std::string entry = record.url + " - " +
+                            std::to_string(record.statusCode) + " - " +
+                            std::to_string(static_cast<int>(record.elapsedTime * 1000)) + "ms" +
+                            (record.fromCache ? (record.revalidated ? " (304)" : " (cache)") : "") +
+                            (record.retries > 0 ? " (" + std::to_string(record.retries) + " retries)" : "") +
+                            (record.hedged ? " (hedged)" : "") +
+                            (record.httpVersion >= 20 ? " (HTTP/2)" : "");
+                        std::string phases = "DNS " + std::to_string(static_cast<int>(record.timing.dns * 1000)) +
+                            " / Connect " + std::to_string(static_cast<int>(record.timing.connect * 1000)) +
+                            " / TLS " + std::to_string(static_cast<int>(record.timing.tls * 1000)) +
+                            " / Wait " + std::to_string(static_cast<int>(record.timing.wait * 1000)) +
+                            " / Download " + std::to_string(static_cast<int>(record.timing.download * 1000)) + " ms";
+
+                        ui.Panel(glm::vec2(panelWidth - 20.0f, 64), [&]() {
                             ui.TextColored(UI::Color::Black, entry);
+                            ui.TextColored(UI::Color::TextSecondary, phases);
                             });
                         ui.Spacing(3.0f);
                     }
@@ -812,12 +945,113 @@ namespace Unicorn {
             ui.Spacing();
 
             if (ui.Button("Clear History", glm::vec2(buttonWidth, 40))) {
-                bgManager.GetRequestHistory(0);
+                bgManager.ClearRequestHistory();
+            }
+
+            if (ui.Button("Export Metrics (JSON)", glm::vec2(buttonWidth, 40))) {
+                ExportRequestMetrics();
             }
 
             ui.EndWindow();
         }
 
+        void RenderLiveEvents(UI::UIContext& ui, float windowWidth, float buttonWidth) {
+            ui.TextColored(UI::Color::Primary, "Live HR Events");
+            ui.Spacing();
+
+            if (ui.InputText("##event_stream_url", m_LiveEvents.url, 512)) {
+                ui.MarkDirty();
+            }
+            ui.Spacing();
+
+            bool subscribed = m_LiveEvents.subscriptionId != 0;
+            if (ui.Button(subscribed ? "Unsubscribe" : "Subscribe", glm::vec2(buttonWidth, 40))) {
+                if (subscribed) StopLiveEvents();
+                else StartLiveEvents();
+            }
+
+            static const char* states[] = { "Connecting", "Open", "Reconnecting", "Closed" };
+            std::string status = std::string("Stream: ") + states[static_cast<int>(m_LiveEvents.state)];
+            if (!m_LiveEvents.error.empty()) {
+                status += " (" + m_LiveEvents.error + ")";
+            }
+            ui.Text(status);
+            ui.Text("Clocked In: " + std::to_string(m_LiveEvents.clockedIn) +
+                "  Leave Requested: " + std::to_string(m_LiveEvents.leaveRequested) +
+                "  Employees Updated: " + std::to_string(m_LiveEvents.employeesUpdated));
+            if (!m_LiveEvents.lastEventId.empty()) {
+                ui.TextColored(UI::Color::TextSecondary, "Last event id: " + m_LiveEvents.lastEventId);
+            }
+
+            for (const auto& entry : m_LiveEvents.recent) {
+                ui.TextColored(UI::Color::TextSecondary, entry);
+            }
+        }
+
+        void StartLiveEvents() {
+            Background::SubscriptionOptions options;
+            options.url = m_LiveEvents.url;
+            // Picks up after the last event seen before an Unsubscribe
+            options.lastEventId = m_LiveEvents.lastEventId;
+
+            auto& bgManager = Background::BackgroundManager::Get();
+            m_LiveEvents.error.clear();
+            m_LiveEvents.state = Background::SubscriptionState::Connecting;
+            m_LiveEvents.subscriptionId = bgManager.Subscribe(options,
+                [this](const Background::ServerEvent& event) {
+                    OnLiveEvent(event);
+                },
+                [this](Background::SubscriptionState state, const std::string& error) {
+                    m_LiveEvents.state = state;
+                    m_LiveEvents.error = error;
+                    if (state == Background::SubscriptionState::Closed) {
+                        m_LiveEvents.subscriptionId = 0;
+                    }
+                    GetUI().MarkDirty();
+                });
+        }
+
+        void StopLiveEvents() {
+            auto& bgManager = Background::BackgroundManager::Get();
+            bgManager.Unsubscribe(m_LiveEvents.subscriptionId);
+
+            m_LiveEvents.subscriptionId = 0;
+            m_LiveEvents.state = Background::SubscriptionState::Closed;
+            m_LiveEvents.error.clear();
+            GetUI().MarkDirty();
+        }
+
+        void OnLiveEvent(const Background::ServerEvent& event) {
+            if (event.type == "attendance.clocked-in") m_LiveEvents.clockedIn++;
+            else if (event.type == "leave.requested") m_LiveEvents.leaveRequested++;
+            else if (event.type == "employee.updated") m_LiveEvents.employeesUpdated++;
+            m_LiveEvents.lastEventId = event.id;
+
+            // Payload's "data" object, enough to tell events apart
+            std::string summary = event.data;
+            size_t data = summary.find("\"data\":");
+            if (data != std::string::npos) summary.erase(0, data + 7);
+            if (summary.size() > 90) summary = summary.substr(0, 87) + "...";
+
+            m_LiveEvents.recent.push_front("#" + event.id + " " + event.type + " " + summary);
+            if (m_LiveEvents.recent.size() > s_RecentLiveEvents) {
+                m_LiveEvents.recent.pop_back();
+            }
+            GetUI().MarkDirty();
+        }
+
+        void ExportRequestMetrics() {
+            const char* path = "request_metrics.json";
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "[API] Failed to write " << path << std::endl;
+                return;
+            }
+
+            file << Background::BackgroundManager::Get().ExportMetricsJson();
+            std::cout << "[API] Metrics exported to " << path << std::endl;
+        }
+
         void TestGETRequest() {
             Background::RequestOptions options;
             options.url = "https://jsonplaceholder.typicode.com/posts/1";
@@ -936,6 +1170,75 @@ namespace Unicorn {
 
             std::cout << "[Test] Large download queued" << std::endl;
         }
+
+        // The same fan-out of GETs (one per record, like the monthly
+        // attendance screen) over HTTP/2, then forced over HTTP/1.1. HTTP/2
+        // goes first: curl would reuse the idle HTTP/1.1 connections.
+        void BenchmarkFanOut() {
+            m_FanOut = FanOutBenchmark();
+            m_FanOut.running = true;
+            StartFanOutPhase(0);
+        }
+
+        void StartFanOutPhase(int phase) {
+            auto& bgManager = Background::BackgroundManager::Get();
+
+            m_FanOut.phase = phase;
+            m_FanOut.remaining = s_FanOutRequests;
+            m_FanOut.failed[phase] = 0;
+            m_FanOut.connectionsBefore = bgManager.GetStats().newConnections;
+            m_FanOut.start = std::chrono::steady_clock::now();
+
+            for (size_t i = 1; i <= s_FanOutRequests; i++) {
+                Background::RequestOptions options;
+                options.url = "https://jsonplaceholder.typicode.com/posts/" + std::to_string(i);
+                options.httpVersion = phase == 0
+                    ? Background::HttpVersion::Auto : Background::HttpVersion::Http1;
+
+                bgManager.Request(options, [this, phase](Background::RequestState state, const Background::Response& response) {
+                    if (state == Background::RequestState::Idle || state == Background::RequestState::Loading) return;
+                    OnFanOutResponse(phase, state);
+                    });
+            }
+
+            std::cout << "[Test] Fan-out benchmark: " << s_FanOutRequests << " requests over "
+                << (phase == 0 ? "HTTP/2" : "HTTP/1.1") << std::endl;
+        }
+
+        void OnFanOutResponse(int phase, Background::RequestState state) {
+            if (!m_FanOut.running || phase != m_FanOut.phase) return;
+
+            if (state != Background::RequestState::Success) {
+                m_FanOut.failed[phase]++;
+            }
+            if (--m_FanOut.remaining > 0) return;
+
+            auto elapsed = std::chrono::steady_clock::now() - m_FanOut.start;
+            m_FanOut.seconds[phase] = std::chrono::duration<double>(elapsed).count();
+            m_FanOut.connections[phase] =
+                Background::BackgroundManager::Get().GetStats().newConnections - m_FanOut.connectionsBefore;
+            m_FanOut.completed = phase + 1;
+            std::cout << "[Test] " << FanOutSummary(phase) << std::endl;
+
+            if (phase == 0) {
+                StartFanOutPhase(1);
+            }
+            else {
+                m_FanOut.running = false;
+            }
+            GetUI().MarkDirty();
+        }
+
+        std::string FanOutSummary(int phase) const {
+            double seconds = m_FanOut.seconds[phase];
+            int perSecond = seconds > 0.0 ? static_cast<int>(s_FanOutRequests / seconds + 0.5) : 0;
+
+            return std::string(phase == 0 ? "HTTP/2: " : "HTTP/1.1: ") +
+                std::to_string(static_cast<int>(seconds * 1000.0)) + " ms, " +
+                std::to_string(perSecond) + " req/s, " +
+                std::to_string(m_FanOut.connections[phase]) + " connections" +
+                (m_FanOut.failed[phase] > 0 ? ", " + std::to_string(m_FanOut.failed[phase]) + " failed" : "");
+        }
 #endif
 
     private:
@@ -948,9 +1251,41 @@ namespace Unicorn {
         std::string m_ApiError;
         int m_ApiResponseCode;
         double m_ApiResponseTime;
+
+        struct FanOutBenchmark {
+            bool running = false;
+            int phase = 0;                  // 0: HTTP/2, 1: HTTP/1.1
+            int completed = 0;              // Phases with results
+            size_t remaining = 0;
+            size_t connectionsBefore = 0;
+            std::chrono::steady_clock::time_point start;
+            double seconds[2] = {};
+            size_t connections[2] = {};     // Opened during the phase
+            size_t failed[2] = {};
+        };
+
+        FanOutBenchmark m_FanOut;
+        static constexpr size_t s_FanOutRequests = 100;
+
+        struct LiveEvents {
+            std::string url;
+            size_t subscriptionId = 0;      // 0: not subscribed
+            Background::SubscriptionState state = Background::SubscriptionState::Closed;
+            std::string error;
+            size_t clockedIn = 0;
+            size_t leaveRequested = 0;
+            size_t employeesUpdated = 0;
+            std::string lastEventId;
+            std::deque<std::string> recent; // Newest first
+        };
+
+        LiveEvents m_LiveEvents;
+        static constexpr size_t s_RecentLiveEvents = 8;
 #endif
         int m_SelectedPage;
         int fpsCounter;
+
+        UI::TextDocument m_EmployeeNotes;
     };
 
     Application* CreateApplication() {
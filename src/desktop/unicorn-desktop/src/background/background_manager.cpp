@@ -8,19 +8,33 @@
 #endif
 
 #include "background_manager.h"
+#include "response_cache.h"
+#include "response_disk_cache.h"
+#include "../core/application.h"
+#ifdef HAVE_ZLIB
+#include "../crypto/crypto_manager.h"
+#endif
 #include <curl/curl.h>
 #include <chrono>
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <cstdio>
 
 namespace Unicorn::Background {
 
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-        size_t totalSize = size * nmemb;
-        std::string* str = static_cast<std::string*>(userp);
-        str->append(static_cast<char*>(contents), totalSize);
-        return totalSize;
+    // The share object is used by the I/O thread and TestConnection, so curl
+    // needs a lock per shared data kind
+    static std::mutex s_ShareLocks[CURL_LOCK_DATA_LAST];
+
+    static void ShareLock(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* /*userptr*/) {
+        s_ShareLocks[data].lock();
+    }
+
+    static void ShareUnlock(CURL* /*handle*/, curl_lock_data data, void* /*userptr*/) {
+        s_ShareLocks[data].unlock();
     }
 
     static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
@@ -45,254 +59,1782 @@ namespace Unicorn::Background {
         return totalSize;
     }
 
-    static int CurlProgressCallback(void* clientp, curl_off_t dltotal, curl_off_t dlnow,
-        curl_off_t /*ultotal*/, curl_off_t /*ulnow*/) {
-        auto* progress = static_cast<ProgressCallback*>(clientp);
+    BackgroundManager::BackgroundManager()
+        : m_ResponseCache(std::make_unique<ResponseCache>())
+        , m_DiskCache(std::make_unique<ResponseDiskCache>()) {}
+
+    BackgroundManager& BackgroundManager::Get() {
+        static BackgroundManager instance;
+        return instance;
+    }
+
+    void BackgroundManager::Init() {
+        curl_global_init(CURL_GLOBAL_ALL);
+
+        m_Multi = curl_multi_init();
+        if (!m_Multi) {
+            std::cerr << "[BackgroundManager] Failed to create CURL multi handle" << std::endl;
+            curl_global_cleanup();
+            return;
+        }
+
+        // HTTP/2 transfers to the same host share one connection
+        curl_multi_setopt(static_cast<CURLM*>(m_Multi), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+        CURLSH* share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, ShareLock);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        }
+        m_Share = share;
+
+        // Last known responses from previous runs
+        m_DiskCache->Open("cache/http.bin");
+
+        m_Running = true;
+        m_IOThread = std::thread(&BackgroundManager::IOLoop, this);
+        std::cout << "[BackgroundManager] Initialized" << std::endl;
+    }
+
+    void BackgroundManager::Shutdown() {
+        if (!m_Running) return;
+
+        m_Running = false;
+        CancelAll();
+        WakeIOThread();
+
+        // The I/O thread aborts whatever is still in flight before it exits
+        if (m_IOThread.joinable()) {
+            m_IOThread.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ActiveRequests.clear();
+            m_InFlight.clear();
+
+            m_PendingRequests.Clear();
+            m_MultiplexedHosts.clear();
+            m_HostLimits.clear();
+            m_QueueBlocked = false;
+
+            for (auto& subscription : m_Subscriptions) {
+                subscription->closed = true;
+            }
+            m_Subscriptions.clear();
+        }
+
+        ClearEasyPool();
+        m_DiskCache->Close();
+
+        curl_multi_cleanup(static_cast<CURLM*>(m_Multi));
+        m_Multi = nullptr;
+
+        if (m_Share) {
+            curl_share_cleanup(static_cast<CURLSH*>(m_Share));
+            m_Share = nullptr;
+        }
+
+        // Cancellations queued while the I/O thread wound down
+        DispatchCallbacks();
+
+        curl_global_cleanup();
+        std::cout << "[BackgroundManager] Shutdown" << std::endl;
+    }
+
+    BackgroundManager::~BackgroundManager() {
+        if (m_Running) {
+            Shutdown();
+        }
+    }
+
+    void BackgroundManager::Update() {
+        if (DispatchCallbacks() > 0) {
+            // One redraw for the whole batch
+            Application::TriggerRender();
+        }
+    }
+
+    void BackgroundManager::PostCallback(const RequestCallback& callback, RequestState state,
+        const Response& response) {
+        if (!callback) return;
+
+        m_Completions.Push({ callback, state, response });
+        m_PostedSinceWake = true;
+    }
+
+    size_t BackgroundManager::DispatchCallbacks() {
+        // Cleared first so anything queued during the drain wakes us again
+        m_WakePending = false;
+
+        return m_Completions.Drain([](Completion& completion) {
+            completion.callback(completion.state, completion.response);
+        });
+    }
+
+    size_t BackgroundManager::Request(const RequestOptions& options, RequestCallback callback) {
+        return RequestWithProgress(options, callback, nullptr, nullptr);
+    }
+
+    size_t BackgroundManager::RequestWithProgress(const RequestOptions& options,
+        RequestCallback callback,
+        ProgressCallback downloadProgress,
+        UploadProgressCallback uploadProgress) {
+        auto request = std::make_shared<RequestData>();
+        request->options = options;
+        request->callback = std::move(callback);
+        if (downloadProgress) {
+            request->downloadProgress = std::make_shared<ProgressRelay>();
+            request->downloadProgress->manager = this;
+            request->downloadProgress->callback = std::move(downloadProgress);
+        }
+        request->uploadProgressCallback = std::move(uploadProgress);
+        request->coalesceKey = CoalesceKey(options);
+        return Submit(request);
+    }
+
+    size_t BackgroundManager::RequestStreaming(const RequestOptions& options,
+        ChunkCallback onChunk,
+        RequestCallback callback) {
+        auto request = std::make_shared<RequestData>();
+        request->options = options;
+        request->callback = std::move(callback);
+        request->chunkCallback = std::move(onChunk);
+        return Submit(request);
+    }
+
+    void BackgroundManager::CompressRequestBody(RequestData& request) {
+        RequestOptions& options = request.options;
+        bool sendsBody = options.method == RequestMethod::POST || options.method == RequestMethod::PUT ||
+            options.method == RequestMethod::PATCH;
+        if (!options.compressBody || !sendsBody || options.body.size() < s_MinCompressedBodySize ||
+            ResponseCache::FindHeader(options.headers, "Content-Encoding")) {
+            return;
+        }
+
+#ifdef HAVE_ZLIB
+        auto result = Crypto::CryptoManager::Get().CompressGzip(
+            reinterpret_cast<const uint8_t*>(options.body.data()), options.body.size());
+
+        // Incompressible payloads go out as they are
+        if (result.success && result.data.size() < options.body.size()) {
+            request.compressedBody = std::move(result.data);
+            options.headers["Content-Encoding"] = "gzip";
+        }
+#endif
+    }
+
+    size_t BackgroundManager::Submit(const std::shared_ptr<RequestData>& request) {
+        CompressRequestBody(*request);
+        request->host = HostKey(request->options.url);
+
+        size_t requestId = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            requestId = m_NextRequestId++;
+
+            auto handle = std::make_shared<RequestHandle>();
+            handle->id = requestId;
+            handle->state = RequestState::Idle;
+            handle->cancelled = false;
+
+            request->id = requestId;
+            request->handle = handle;
+            request->priority = request->options.priority;
+            const RequestCallback& callback = request->callback;
+
+            m_Handles[requestId] = handle;
+
+            if (callback) {
+                callback(RequestState::Idle, handle->response);
+            }
+        }
+
+        // Cache answers never queue behind a host's limit: a hit is delivered
+        // here and a stale copy shown now, before the revalidation is queued.
+        // The I/O thread normally wakes the main loop for callbacks; this
+        // runs on the caller's thread, so it wakes it itself.
+        bool answered = ApplyCachePolicy(request);
+        if (answered || (request->hasCachedResponse && request->options.staleWhileRevalidate)) {
+            if (!m_WakePending.exchange(true)) {
+                Application::WakeMainLoop();
+            }
+        }
+        if (answered) return requestId;
+
+        bool coalesced = false;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            const RequestCallback& callback = request->callback;
+            RequestHandle& handle = *request->handle;
+
+            // The same GET is already queued or running: wait for its result
+            auto leader = request->coalesceKey.empty()
+                ? m_InFlight.end() : m_InFlight.find(request->coalesceKey);
+            if (leader != m_InFlight.end()) {
+                leader->second->followers.push_back(request);
+                coalesced = true;
+
+                // The shared transfer is as urgent as its most urgent caller
+                if (request->priority < leader->second->priority) {
+                    leader->second->priority = request->priority;
+                    m_PendingRequests.Reprioritize(
+                        [&](const std::shared_ptr<RequestData>& pending) { return pending == leader->second; },
+                        static_cast<size_t>(request->priority));
+                }
+
+                if (leader->second->handle->state == RequestState::Loading) {
+                    handle.state = RequestState::Loading;
+                    if (callback) {
+                        callback(RequestState::Loading, handle.response);
+                    }
+                }
+            }
+            else {
+                if (!request->coalesceKey.empty()) {
+                    m_InFlight[request->coalesceKey] = request;
+                }
+                m_PendingRequests.Push(request, static_cast<size_t>(request->priority));
+                m_QueueBlocked = false;
+            }
+        }
+
+        if (coalesced) {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.coalescedRequests++;
+            return requestId;
+        }
+
+        WakeIOThread();
+        return requestId;
+    }
+
+    // ============================================================================
+    // I/O THREAD
+    // ============================================================================
+
+    void BackgroundManager::WakeIOThread() {
+        if (m_Multi) {
+            curl_multi_wakeup(static_cast<CURLM*>(m_Multi));
+        }
+    }
+
+    void BackgroundManager::IOLoop() {
+        CURLM* multi = static_cast<CURLM*>(m_Multi);
+
+        while (m_Running) {
+            size_t perHost = m_MaxConnectionsPerHost;
+            if (perHost != m_AppliedConnectionsPerHost) {
+                curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(perHost));
+                m_AppliedConnectionsPerHost = perHost;
+            }
+
+            size_t streams = m_MaxConcurrentStreams;
+            if (streams != m_AppliedConcurrentStreams) {
+                curl_multi_setopt(multi, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(streams));
+                m_AppliedConcurrentStreams = streams;
+            }
+
+            StartDueRetries();
+            StartDueSubscriptions();
+            StartPendingTransfers();
+            AbortCancelledTransfers();
+            LaunchDueHedges();
+
+            int running = 0;
+            CURLMcode code = curl_multi_perform(multi, &running);
+            if (code != CURLM_OK) {
+                std::cerr << "[BackgroundManager] curl_multi_perform: "
+                    << curl_multi_strerror(code) << std::endl;
+            }
+
+            int remaining = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi, &remaining)) {
+                if (message->msg != CURLMSG_DONE) continue;
+
+                RequestData* raw = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &raw);
+                CURLcode result = message->data.result;
+
+                std::shared_ptr<RequestData> request;
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    auto it = std::find_if(m_ActiveRequests.begin(), m_ActiveRequests.end(),
+                        [raw](const std::shared_ptr<RequestData>& active) { return active.get() == raw; });
+                    if (it != m_ActiveRequests.end()) request = *it;
+                }
+
+                if (request) {
+                    FinishTransfer(request, result);
+                    continue;
+                }
+
+                auto hedge = std::find_if(m_Hedges.begin(), m_Hedges.end(),
+                    [raw](const std::shared_ptr<RequestData>& active) { return active.get() == raw; });
+                if (hedge != m_Hedges.end()) {
+                    // Copied: FinishHedge removes it from m_Hedges
+                    std::shared_ptr<RequestData> finished = *hedge;
+                    FinishHedge(finished, result);
+                }
+            }
+
+            if (m_PostedSinceWake.exchange(false)) {
+                if (!m_WakePending.exchange(true)) {
+                    Application::WakeMainLoop();
+                }
+            }
+
+            // Sleeps until a socket is ready, a timeout is due, or
+            // WakeIOThread() is called for new work, a cancel or shutdown
+            curl_multi_poll(multi, nullptr, 0, NextTimerMs(), nullptr);
+        }
+
+        // Shutting down: everything still on the multi handle is cancelled
+        std::vector<std::shared_ptr<RequestData>> remaining;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            remaining = m_ActiveRequests;
+        }
+        for (auto& request : remaining) {
+            FinishTransfer(request, CURLE_ABORTED_BY_CALLBACK);
+        }
+        m_Retrying.clear();
+    }
+
+    void BackgroundManager::StartPendingTransfers() {
+        std::vector<std::shared_ptr<RequestData>> starting;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_QueueBlocked) return;
+
+            size_t perHost = m_MaxConnectionsPerHost;
+            size_t maxStreams = m_MaxConcurrentStreams;
+            bool reserved = false;
+
+            // A request needs room under its host's limit, which HTTP/2
+            // hosts can raise up to the stream limit and others up to the
+            // connection limit. The last slot of a host is kept for
+            // on-screen work, so a queue of prefetch or bulk transfers never
+            // delays a click. A full host does not hold up the others queued
+            // within the first s_DispatchScanLimit of each class.
+            auto accept = [&](const std::shared_ptr<RequestData>& request, size_t agedClass) {
+                if (request->subscription) return true;
+
+                ConcurrencyLimiter& limiter = HostLimiter(request->host);
+                limiter.SetCeiling(m_MultiplexedHosts.count(request->host) > 0 ? maxStreams : perHost);
+
+                size_t limit = limiter.Limit();
+                if (limiter.InFlight() >= limit) return false;
+                if (limit > 1 && limiter.InFlight() + 1 >= limit &&
+                    agedClass > static_cast<size_t>(RequestPriority::Visible)) {
+                    reserved = true;
+                    return false;
+                }
+                return true;
+            };
+
+            auto now = std::chrono::steady_clock::now();
+            std::shared_ptr<RequestData> request;
+            while (m_PendingRequests.PopIf(request, accept, s_DispatchScanLimit, now)) {
+                if (!request->subscription) {
+                    HostLimiter(request->host).Acquire();
+                }
+                request->handle->state = RequestState::Loading;
+                m_ActiveRequests.push_back(request);
+                starting.push_back(std::move(request));
+            }
+
+            // Waiting on the reserved slot can end by aging alone, so that
+            // queue is looked at again on the next pass
+            m_QueueBlocked = !m_PendingRequests.Empty() && !reserved;
+        }
+
+        for (auto& request : starting) {
+            PostCallback(request->callback, RequestState::Loading, request->handle->response);
+
+            std::vector<std::shared_ptr<RequestData>> followers;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                followers = request->followers;
+                for (auto& follower : followers) {
+                    follower->handle->state = RequestState::Loading;
+                }
+            }
+            for (auto& follower : followers) {
+                PostCallback(follower->callback, RequestState::Loading, follower->handle->response);
+            }
+
+            if (request->handle->cancelled && !DetachCancelledLeader(request)) {
+                FinishTransfer(request, CURLE_ABORTED_BY_CALLBACK);
+            }
+            else if (!AllowHost(*request)) {
+                FinishTransfer(request, CURLE_COULDNT_CONNECT);
+            }
+            else if (!StartTransfer(request)) {
+                FinishTransfer(request, CURLE_FAILED_INIT);
+            }
+        }
+    }
+
+    // ============================================================================
+    // EASY HANDLE POOL
+    // ============================================================================
+
+    std::string BackgroundManager::HostKey(const std::string& url) {
+        // scheme://authority, lowercased; paths and queries share the handle
+        size_t schemeEnd = url.find("://");
+        size_t authorityStart = schemeEnd == std::string::npos ? 0 : schemeEnd + 3;
+        size_t authorityEnd = url.find_first_of("/?#", authorityStart);
+
+        std::string key = url.substr(0, authorityEnd);
+        std::transform(key.begin(), key.end(), key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return key;
+    }
+
+    void* BackgroundManager::AcquireEasy(const std::string& host) {
+        auto it = m_EasyPool.find(host);
+        if (it != m_EasyPool.end() && !it->second.empty()) {
+            CURL* curl = static_cast<CURL*>(it->second.back());
+            it->second.pop_back();
+            return curl;
+        }
+
+        return curl_easy_init();
+    }
+
+    void BackgroundManager::ReleaseEasy(const std::string& host, void* easy) {
+        CURL* curl = static_cast<CURL*>(easy);
+
+        // Reset drops the options but keeps the handle's caches; the share
+        // is attached again in StartTransfer
+        curl_easy_reset(curl);
+
+        auto& pool = m_EasyPool[host];
+        if (pool.size() < s_MaxPooledHandlesPerHost) {
+            pool.push_back(curl);
+        }
+        else {
+            curl_easy_cleanup(curl);
+        }
+    }
+
+    void BackgroundManager::ClearEasyPool() {
+        for (auto& [host, pool] : m_EasyPool) {
+            for (void* easy : pool) {
+                curl_easy_cleanup(static_cast<CURL*>(easy));
+            }
+        }
+        m_EasyPool.clear();
+    }
+
+    bool BackgroundManager::CanMultiplex(const RequestData& request) {
+        // Cleartext Auto requests speak HTTP/1.1, which never multiplexes
+        switch (request.options.httpVersion) {
+        case HttpVersion::Http1:
+            return false;
+        case HttpVersion::Http2PriorKnowledge:
+            return true;
+        default:
+            return request.host.rfind("https://", 0) == 0;
+        }
+    }
+
+    bool BackgroundManager::StartTransfer(const std::shared_ptr<RequestData>& request) {
+        request->host = HostKey(request->options.url);
+
+        CURL* curl = static_cast<CURL*>(AcquireEasy(request->host));
+        if (!curl) {
+            return false;
+        }
+
+        request->easy = curl;
+        request->attemptStart = std::chrono::steady_clock::now();
+        if (request->startTime == std::chrono::steady_clock::time_point{}) {
+            request->startTime = request->attemptStart;
+        }
+
+        if (m_Share) {
+            curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH*>(m_Share));
+        }
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
+        curl_easy_setopt(curl, CURLOPT_URL, request->options.url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteBody);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, request.get());
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &request->responseHeaders);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, request->options.timeoutSeconds);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, request->options.followRedirects ? 1L : 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+        switch (request->options.httpVersion) {
+        case HttpVersion::Http1:
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+            break;
+        case HttpVersion::Http2PriorKnowledge:
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE));
+            break;
+        default:
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+            break;
+        }
+
+        if (CanMultiplex(*request)) {
+            // A burst to a host that is still connecting waits for that
+            // connection and multiplexes over it instead of opening more
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        }
+
+        if (request->subscription) {
+            // No overall timeout; a stream that stays silent for the idle
+            // timeout (servers send comments to keep it alive) is dead
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME,
+                static_cast<long>(std::max(request->subscription->options.idleTimeoutSeconds, 1)));
+        }
+
+        if (request->options.useCompression) {
+            // Empty string: every encoding this libcurl can decode
+            curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+        }
+
+        if (request->downloadProgress) {
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, TransferProgress);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, request.get());
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        }
+
+        // Explicit sizes, so gzip (binary) bodies are not cut at a NUL
+        const char* body = request->options.body.data();
+        curl_off_t bodySize = static_cast<curl_off_t>(request->options.body.size());
+        if (!request->compressedBody.empty()) {
+            body = reinterpret_cast<const char*>(request->compressedBody.data());
+            bodySize = static_cast<curl_off_t>(request->compressedBody.size());
+        }
+
+        switch (request->options.method) {
+        case RequestMethod::POST:
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, bodySize);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            break;
+        case RequestMethod::PUT:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, bodySize);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            break;
+        case RequestMethod::HTTP_DELETE:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+            break;
+        case RequestMethod::PATCH:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, bodySize);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            break;
+        default:
+            break;
+        }
+
+        struct curl_slist* headers = nullptr;
+        for (const auto& [key, value] : request->options.headers) {
+            std::string header = key + ": " + value;
+            headers = curl_slist_append(headers, header.c_str());
+        }
+        if (headers) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+            request->headerList = headers;
+        }
+
+        if (curl_multi_add_handle(static_cast<CURLM*>(m_Multi), curl) != CURLM_OK) {
+            return false;
+        }
+
+        ArmHedge(*request);
+        return true;
+    }
+
+    void BackgroundManager::ReleaseTransfer(RequestData& request) {
+        if (request.easy) {
+            CURL* curl = static_cast<CURL*>(request.easy);
+            curl_multi_remove_handle(static_cast<CURLM*>(m_Multi), curl);
+            ReleaseEasy(request.host, curl);
+            request.easy = nullptr;
+        }
+        if (request.headerList) {
+            curl_slist_free_all(static_cast<curl_slist*>(request.headerList));
+            request.headerList = nullptr;
+        }
+    }
+
+    void BackgroundManager::AbortCancelledTransfers() {
+        std::vector<std::shared_ptr<RequestData>> cancelled;
+        std::vector<std::shared_ptr<RequestData>> cancelledFollowers;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (const auto& request : m_ActiveRequests) {
+                if (request->handle->cancelled) {
+                    cancelled.push_back(request);
+                }
+
+                auto& followers = request->followers;
+                for (const auto& follower : followers) {
+                    if (follower->handle->cancelled) cancelledFollowers.push_back(follower);
+                }
+                std::erase_if(followers, [](const std::shared_ptr<RequestData>& follower) {
+                    return follower->handle->cancelled.load();
+                });
+            }
+        }
+
+        for (auto& follower : cancelledFollowers) {
+            DeliverCancelled(follower);
+        }
+
+        for (auto& request : cancelled) {
+            if (!DetachCancelledLeader(request)) {
+                FinishTransfer(request, CURLE_ABORTED_BY_CALLBACK);
+            }
+        }
+    }
+
+    bool BackgroundManager::DetachCancelledLeader(const std::shared_ptr<RequestData>& request) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            bool waiting = std::any_of(request->followers.begin(), request->followers.end(),
+                [](const std::shared_ptr<RequestData>& follower) { return !follower->handle->cancelled; });
+            if (!waiting) return false;
+        }
+
+        // The caller gets its Cancelled result now; the transfer continues
+        // under a fresh handle that nobody can cancel by id
+        auto transferHandle = std::make_shared<RequestHandle>();
+        transferHandle->id = request->id;
+        transferHandle->state = RequestState::Loading;
+        transferHandle->startTime = request->handle->startTime;
+
+        DeliverCancelled(request);
+
+        request->handle = transferHandle;
+        request->callback = nullptr;
+        request->downloadProgress = nullptr;
+        request->uploadProgressCallback = nullptr;
+        request->detached = true;
+        return true;
+    }
+
+    void BackgroundManager::DeliverCancelled(const std::shared_ptr<RequestData>& request) {
+        Response response;
+        response.error = "Request cancelled";
+        PublishResult(*request->handle, RequestState::Cancelled, response);
+
+        PostCallback(request->callback, RequestState::Cancelled, response);
+        UpdateStats(response, RequestState::Cancelled);
+        CompleteRequest(request->id);
+    }
+
+    void BackgroundManager::PublishResult(RequestHandle& handle, RequestState state, const Response& response) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        handle.response = response;
+        handle.state = state;
+    }
+
+    std::string BackgroundManager::CoalesceKey(const RequestOptions& options) {
+        if ((options.method != RequestMethod::GET && options.method != RequestMethod::HEAD) ||
+            !options.body.empty()) {
+            return {};
+        }
+
+        // Everything that can change the outcome must match
+        std::vector<std::string> headers;
+        headers.reserve(options.headers.size());
+        for (const auto& [name, value] : options.headers) {
+            headers.push_back(name + ": " + value);
+        }
+        std::sort(headers.begin(), headers.end());
+
+        std::string key = (options.method == RequestMethod::HEAD ? "HEAD " : "GET ") + options.url;
+        key += '\n' + std::to_string(static_cast<int>(options.cachePolicy));
+        key += options.staleWhileRevalidate ? " swr" : "";
+        key += ' ' + std::to_string(options.timeoutSeconds);
+        key += options.followRedirects ? " follow" : "";
+        key += " r" + std::to_string(options.retryCount);
+        for (const auto& header : headers) {
+            key += '\n';
+            key += header;
+        }
+        return key;
+    }
+
+    size_t BackgroundManager::WriteBody(char* data, size_t size, size_t nmemb, void* userdata) {
+        size_t totalSize = size * nmemb;
+        auto* request = static_cast<RequestData*>(userdata);
+        request->decodedBytes += totalSize;
+
+        if (request->chunkCallback) {
+            request->chunkCallback(std::string_view(data, totalSize));
+            return totalSize;
+        }
+
+        if (!request->body) {
+            // Headers are complete by the first write, so the length is known
+            // when the server sent one and the body lands in a single buffer
+            curl_off_t contentLength = -1;
+            curl_easy_getinfo(static_cast<CURL*>(request->easy), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+            size_t capacity = contentLength > 0
+                ? static_cast<size_t>(std::min<curl_off_t>(contentLength, s_MaxPresizeBytes)) : totalSize;
+            request->body = std::make_shared<BodyBuffer>(capacity);
+        }
+
+        request->body->Append(data, totalSize);
+        return totalSize;
+    }
+
+    static_assert(std::is_same_v<curl_off_t, int64_t>, "TransferProgress is declared with int64_t");
+
+    int BackgroundManager::TransferProgress(void* clientp, int64_t dltotal, int64_t dlnow,
+        int64_t /*ultotal*/, int64_t /*ulnow*/) {
+        auto* request = static_cast<RequestData*>(clientp);
+        const std::shared_ptr<ProgressRelay>& relay = request->downloadProgress;
+        if (!relay || dltotal <= 0) return 0;
+
+        // curl also calls this while nothing moves
+        auto current = static_cast<size_t>(dlnow);
+        auto total = static_cast<size_t>(dltotal);
+        if (relay->current.load() == current && relay->total.load() == total) return 0;
+        relay->current = current;
+        relay->total = total;
+
+        // A dispatch already queued will pick up these counts
+        if (relay->queued.exchange(true)) return 0;
+
+        static const Response s_NoResponse;
+        relay->manager->PostCallback([relay](RequestState, const Response&) {
+            relay->queued = false;
+            relay->callback(relay->current.load(), relay->total.load());
+        }, RequestState::Loading, s_NoResponse);
+        return 0;
+    }
+
+    bool BackgroundManager::RemoveActive(const std::shared_ptr<RequestData>& request) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = std::find(m_ActiveRequests.begin(), m_ActiveRequests.end(), request);
+        if (it == m_ActiveRequests.end()) return false;
+        m_ActiveRequests.erase(it);
+
+        auto limiter = m_HostLimits.find(request->host);
+        if (limiter != m_HostLimits.end() && !request->subscription) {
+            limiter->second.Release();
+        }
+        m_QueueBlocked = false;
+        return true;
+    }
+
+    void BackgroundManager::FinishTransfer(const std::shared_ptr<RequestData>& request, int curlResult) {
+        CURLcode res = static_cast<CURLcode>(curlResult);
+        CURL* curl = static_cast<CURL*>(request->easy);
+        // Built here and published to the handle in one step: GetResponse()
+        // may read the handle from the UI thread at any time
+        Response response;
+        RequestState state = RequestState::Error;
+
+        // Whichever of the two answered, the other transfer is not needed
+        CancelHedge(*request);
+        std::erase(m_Retrying, request);
+
+        bool attempted = curl && !request->handle->cancelled;
+        long statusCode = 0;
+        if (attempted) {
+            if (res == CURLE_OK) {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+            }
+
+            // A stream's minutes-long life is not a request latency and its
+            // drops are not the host failing; OnSubscriptionEnded backs off
+            if (!request->subscription) {
+                bool failed = (res != CURLE_OK && res != CURLE_ABORTED_BY_CALLBACK) ||
+                    (statusCode >= 502 && statusCode <= 504);
+                RecordOutcome(*request, failed);
+                RecordConcurrencySample(*request, res, statusCode);
+            }
+        }
+
+        if (request->probe) {
+            // A finished (or abandoned) probe lets the next request decide
+            request->probe = false;
+            m_Breakers[request->host].probing = false;
+        }
+
+        if (attempted && ScheduleRetry(request, res, statusCode)) {
+            return;
+        }
+
+        if (!RemoveActive(request)) return;
+
+        auto endTime = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - request->startTime);
+
+        response.elapsedTime = curl ? duration.count() / 1000.0 : 0.0;
+        if (request->body) {
+            response.body = BodyView(std::move(request->body));
+        }
+        response.headers = std::move(request->responseHeaders);
+
+        if (curl) {
+            double downloadSize = 0;
+            curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &downloadSize);
+            response.downloadSize = static_cast<size_t>(downloadSize);
+
+            double uploadSize = 0;
+            curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &uploadSize);
+            response.uploadSize = static_cast<size_t>(uploadSize);
+
+            response.decodedDownloadSize = request->decodedBytes;
+            response.rawUploadSize = response.uploadSize > 0 ? request->options.body.size() : 0;
+
+            long newConnections = 0;
+            curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+            response.reusedConnection = res == CURLE_OK && newConnections == 0;
+
+            long httpVersion = 0;
+            curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &httpVersion);
+            switch (httpVersion) {
+            case CURL_HTTP_VERSION_1_0: response.httpVersion = 10; break;
+            case CURL_HTTP_VERSION_1_1: response.httpVersion = 11; break;
+            case CURL_HTTP_VERSION_2_0: response.httpVersion = 20; break;
+            case CURL_HTTP_VERSION_3: response.httpVersion = 30; break;
+            default: response.httpVersion = 0; break;
+            }
+
+            // What the host answered with decides how its next requests are
+            // scheduled; a server that stops offering HTTP/2 gets slots again.
+            // Forced HTTP/1.1 answers say nothing about the host.
+            if (res == CURLE_OK && response.httpVersion != 0 && CanMultiplex(*request)) {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if (response.httpVersion >= 20) {
+                    m_MultiplexedHosts.insert(request->host);
+                }
+                else {
+                    m_MultiplexedHosts.erase(request->host);
+                }
+            }
+
+            // curl reports cumulative times since the transfer started
+            curl_off_t nameLookup = 0, connect = 0, appConnect = 0, startTransfer = 0, total = 0;
+            curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+            curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+            curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+            curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &startTransfer);
+            curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+
+            auto phase = [](curl_off_t from, curl_off_t to) {
+                return to > from ? static_cast<double>(to - from) / 1e6 : 0.0;
+            };
+            curl_off_t handshakeDone = std::max(connect, appConnect);
+            response.timing.dns = phase(0, nameLookup);
+            response.timing.connect = phase(nameLookup, connect);
+            response.timing.tls = appConnect > 0 ? phase(connect, appConnect) : 0.0;
+            response.timing.wait = startTransfer > 0 ? phase(handshakeDone, startTransfer) : 0.0;
+            response.timing.download = startTransfer > 0 ? phase(startTransfer, total) : 0.0;
+        }
+
+        if (request->handle->cancelled) {
+            state = RequestState::Cancelled;
+            response.error = "Request cancelled";
+        }
+        else if (res == CURLE_OPERATION_TIMEDOUT) {
+            state = RequestState::Timeout;
+            response.error = curl_easy_strerror(res);
+        }
+        else if (res != CURLE_OK) {
+            state = RequestState::Error;
+            if (request->shortCircuited) {
+                response.error = "Circuit open for " + request->host;
+            }
+            else {
+                response.error = res == CURLE_FAILED_INIT
+                    ? "Failed to initialize CURL" : curl_easy_strerror(res);
+            }
+        }
+        else {
+            long statusCode = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+            response.statusCode = static_cast<int>(statusCode);
+
+            if (statusCode >= 200 && statusCode < 300) {
+                state = RequestState::Success;
+            }
+            else {
+                state = RequestState::Error;
+                response.error = "HTTP " + std::to_string(statusCode);
+            }
+        }
+
+        if (!request->cacheKey.empty() && !request->handle->cancelled) {
+            if (response.statusCode == 304 && request->hasCachedResponse) {
+                // Unchanged: keep the cached body, take the new freshness
+                m_ResponseCache->Refresh(request->cacheKey, response);
+
+                Response cached = std::move(request->cachedResponse);
+                cached.elapsedTime = response.elapsedTime;
+                cached.downloadSize = response.downloadSize;
+                cached.decodedDownloadSize = response.decodedDownloadSize;
+                cached.rawUploadSize = response.rawUploadSize;
+                cached.uploadSize = response.uploadSize;
+                cached.reusedConnection = response.reusedConnection;
+                cached.httpVersion = response.httpVersion;
+                cached.timing = response.timing;
+                cached.fromCache = true;
+                cached.revalidated = true;
+                response = std::move(cached);
+                state = RequestState::Success;
+            }
+            else if (state == RequestState::Success) {
+                m_ResponseCache->Store(request->cacheKey, response);
+                m_DiskCache->Store(request->cacheKey, response);
+            }
+            else if (request->options.cachePolicy == CachePolicy::NetworkFirst &&
+                request->hasCachedResponse && (response.statusCode == 0 || response.statusCode >= 500)) {
+                // Server unreachable or failing: last known data beats an error
+                Response cached = std::move(request->cachedResponse);
+                cached.elapsedTime = response.elapsedTime;
+                cached.fromCache = true;
+                response = std::move(cached);
+                state = RequestState::Success;
+            }
+        }
+
+        ReleaseTransfer(*request);
+        DeliverResult(request, std::move(response), state);
+    }
+
+    void BackgroundManager::DeliverResult(const std::shared_ptr<RequestData>& request,
+        Response response, RequestState state) {
+        // New identical requests start their own transfer from here on
+        std::vector<std::shared_ptr<RequestData>> followers;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            request->handle->response = response;
+            request->handle->state = state;
+
+            if (!request->coalesceKey.empty()) {
+                auto it = m_InFlight.find(request->coalesceKey);
+                if (it != m_InFlight.end() && it->second == request) {
+                    m_InFlight.erase(it);
+                }
+            }
+            followers.swap(request->followers);
+        }
+
+        // The transfer's bytes and connection are counted once
+        bool accounted = false;
+        if (!request->detached) {
+            PostCallback(request->callback, state, response);
+            UpdateStats(response, state, !request->subscription);
+            CompleteRequest(request->id);
+            accounted = true;
+        }
+
+        for (auto& follower : followers) {
+            if (follower->handle->cancelled) {
+                DeliverCancelled(follower);
+                continue;
+            }
+
+            Response shared = response;
+            shared.coalesced = accounted;
+            accounted = true;
+            PublishResult(*follower->handle, state, shared);
+
+            PostCallback(follower->callback, state, shared);
+            UpdateStats(shared, state);
+            CompleteRequest(follower->id);
+        }
+
+        RecordHistory(*request, response, state);
+    }
+
+    // ============================================================================
+    // RETRIES, HEDGING AND CIRCUIT BREAKER
+    // ============================================================================
+
+    static bool IsIdempotent(RequestMethod method) {
+        return method != RequestMethod::POST && method != RequestMethod::PATCH;
+    }
+
+    static bool IsTransient(CURLcode res, long statusCode) {
+        switch (res) {
+        case CURLE_OK:
+            return statusCode == 408 || statusCode == 429 ||
+                (statusCode >= 502 && statusCode <= 504);
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_OPERATION_TIMEDOUT:
+        case CURLE_SEND_ERROR:
+        case CURLE_RECV_ERROR:
+        case CURLE_GOT_NOTHING:
+        case CURLE_PARTIAL_FILE:
+        case CURLE_HTTP2:
+        case CURLE_HTTP2_STREAM:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void BackgroundManager::LatencyWindow::Add(double seconds) {
+        if (samples.size() < s_LatencyWindowSize) {
+            samples.push_back(seconds);
+        }
+        else {
+            samples[next] = seconds;
+        }
+        next = (next + 1) % s_LatencyWindowSize;
+    }
+
+    double BackgroundManager::LatencyWindow::Percentile(double percentile) const {
+        if (samples.empty()) return 0.0;
+
+        std::vector<double> sorted = samples;
+        size_t rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+        rank = std::min(rank, sorted.size() - 1);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        return sorted[rank];
+    }
+
+    std::string BackgroundManager::EndpointKey(const RequestOptions& options) {
+        // Method and URL without query or fragment: /users?page=2 and
+        // /users?page=3 share a latency profile
+        static const char* methods[] = { "GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "OPTIONS" };
+        std::string key = methods[static_cast<int>(options.method)];
+        key += ' ';
+        key += options.url.substr(0, options.url.find_first_of("?#"));
+        return key;
+    }
+
+    bool BackgroundManager::ScheduleRetry(const std::shared_ptr<RequestData>& request,
+        int curlResult, long statusCode) {
+        const RequestOptions& options = request->options;
+        int attempt = request->handle->currentRetry;
+
+        // Streamed chunks cannot be taken back, so those are never repeated
+        if (!m_Running || attempt >= options.retryCount || !IsIdempotent(options.method) ||
+            request->chunkCallback || !IsTransient(static_cast<CURLcode>(curlResult), statusCode)) {
+            return false;
+        }
+
+        // Exponential backoff with "equal jitter": at least half the step, so
+        // a burst of failures does not retry in lockstep
+        int64_t step = static_cast<int64_t>(std::max(options.retryDelayMs, 1)) << std::min(attempt, 16);
+        step = std::min<int64_t>(step, s_MaxRetryDelayMs);
+        std::uniform_int_distribution<int64_t> jitter(step / 2, step);
+        int64_t delayMs = jitter(m_Random);
+
+        if (statusCode == 429 || statusCode == 503) {
+            if (const std::string* retryAfter = ResponseCache::FindHeader(request->responseHeaders, "Retry-After")) {
+                int64_t seconds = std::atoll(retryAfter->c_str());
+                delayMs = std::clamp<int64_t>(seconds * 1000, delayMs, s_MaxRetryDelayMs);
+            }
+        }
+
+        // The request keeps its slot and stays cancellable while it waits
+        ReleaseTransfer(*request);
+        request->body.reset();
+        request->responseHeaders.clear();
+        request->decodedBytes = 0;
+        request->handle->currentRetry = attempt + 1;
+        request->retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+        m_Retrying.push_back(request);
+
+        {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.retries++;
+        }
+        return true;
+    }
+
+    void BackgroundManager::StartDueRetries() {
+        auto now = std::chrono::steady_clock::now();
+
+        std::vector<std::shared_ptr<RequestData>> due;
+        std::erase_if(m_Retrying, [&](const std::shared_ptr<RequestData>& request) {
+            if (request->retryAt > now) return false;
+            due.push_back(request);
+            return true;
+        });
+
+        for (auto& request : due) {
+            // Cancelled while waiting: AbortCancelledTransfers finishes it
+            if (request->handle->cancelled) continue;
+
+            if (!AllowHost(*request)) {
+                FinishTransfer(request, CURLE_COULDNT_CONNECT);
+            }
+            else if (!StartTransfer(request)) {
+                FinishTransfer(request, CURLE_FAILED_INIT);
+            }
+        }
+    }
+
+    void BackgroundManager::ArmHedge(RequestData& request) {
+        request.hedgeAt = {};
+
+        const RequestOptions& options = request.options;
+        if (!options.hedge || request.hedgeOf || request.chunkCallback ||
+            (options.method != RequestMethod::GET && options.method != RequestMethod::HEAD)) {
+            return;
+        }
+
+        // No hedging until the endpoint has a latency profile
+        auto it = m_Latency.find(EndpointKey(options));
+        if (it == m_Latency.end() || it->second.samples.size() < s_MinHedgeSamples) return;
+
+        double delay = std::max(it->second.Percentile(options.hedgePercentile), 0.005);
+        request.hedgeAt = request.attemptStart +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(delay));
+    }
+
+    void BackgroundManager::LaunchDueHedges() {
+        auto now = std::chrono::steady_clock::now();
+
+        std::vector<std::shared_ptr<RequestData>> due;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (const auto& request : m_ActiveRequests) {
+                if (request->easy && !request->hedge &&
+                    request->hedgeAt != std::chrono::steady_clock::time_point{} && request->hedgeAt <= now) {
+                    due.push_back(request);
+                }
+            }
+        }
+
+        for (auto& request : due) {
+            request->hedgeAt = {};
+            if (m_Hedges.size() >= s_MaxHedges || request->handle->cancelled) continue;
+
+            // A duplicate of the transfer only: no callbacks, cache or retries
+            auto hedge = std::make_shared<RequestData>();
+            hedge->id = request->id;
+            hedge->options = request->options;
+            hedge->handle = std::make_shared<RequestHandle>();
+            hedge->hedgeOf = request.get();
+
+            if (!AllowHost(*hedge)) continue;
+            if (!StartTransfer(hedge)) {
+                ReleaseTransfer(*hedge);
+                continue;
+            }
+
+            request->hedge = hedge;
+            m_Hedges.push_back(hedge);
+
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.hedgedRequests++;
+        }
+    }
+
+    void BackgroundManager::FinishHedge(const std::shared_ptr<RequestData>& hedge, int curlResult) {
+        CURLcode res = static_cast<CURLcode>(curlResult);
+        std::erase(m_Hedges, hedge);
+
+        long statusCode = 0;
+        if (res == CURLE_OK) {
+            curl_easy_getinfo(static_cast<CURL*>(hedge->easy), CURLINFO_RESPONSE_CODE, &statusCode);
+        }
+        bool usable = res == CURLE_OK && !IsTransient(res, statusCode) && statusCode < 500;
+
+        std::shared_ptr<RequestData> request;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = std::find_if(m_ActiveRequests.begin(), m_ActiveRequests.end(),
+                [&](const std::shared_ptr<RequestData>& active) { return active.get() == hedge->hedgeOf; });
+            if (it != m_ActiveRequests.end()) request = *it;
+        }
+
+        if (!usable || !request || !request->easy || request->handle->cancelled) {
+            RecordOutcome(*hedge, res != CURLE_OK || statusCode >= 500);
+            if (hedge->probe) {
+                hedge->probe = false;
+                m_Breakers[hedge->host].probing = false;
+            }
+            if (request && request->hedge == hedge) request->hedge.reset();
+            ReleaseTransfer(*hedge);
+            return;
+        }
+
+        // The duplicate answered first: drop the original attempt and finish
+        // the request with the duplicate's transfer
+        request->hedge.reset();
+        ReleaseTransfer(*request);
+
+        request->easy = hedge->easy;
+        request->headerList = hedge->headerList;
+        request->body = std::move(hedge->body);
+        request->responseHeaders = std::move(hedge->responseHeaders);
+        request->decodedBytes = hedge->decodedBytes;
+        request->attemptStart = hedge->attemptStart;
+        request->probe = hedge->probe;
+        request->hedgeWon = true;
+        hedge->easy = nullptr;
+        hedge->headerList = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.hedgeWins++;
+        }
+
+        FinishTransfer(request, CURLE_OK);
+    }
+
+    void BackgroundManager::CancelHedge(RequestData& request) {
+        if (!request.hedge) return;
+
+        auto hedge = std::move(request.hedge);
+        if (hedge->probe) {
+            m_Breakers[hedge->host].probing = false;
+        }
+        ReleaseTransfer(*hedge);
+        std::erase(m_Hedges, hedge);
+    }
+
+    int BackgroundManager::NextTimerMs() const {
+        auto now = std::chrono::steady_clock::now();
+        auto next = now + std::chrono::milliseconds(1000);
+
+        for (const auto& request : m_Retrying) {
+            next = std::min(next, request->retryAt);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (const auto& subscription : m_Subscriptions) {
+                if (subscription->connectPending) {
+                    next = std::min(next, subscription->reconnectAt);
+                }
+            }
+            for (const auto& request : m_ActiveRequests) {
+                if (request->hedgeAt != std::chrono::steady_clock::time_point{}) {
+                    next = std::min(next, request->hedgeAt);
+                }
+            }
+        }
+
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+        return static_cast<int>(std::clamp<int64_t>(ms, 0, 1000));
+    }
+
+    bool BackgroundManager::AllowHost(RequestData& request) {
+        request.host = HostKey(request.options.url);
+
+        auto it = m_Breakers.find(request.host);
+        if (it == m_Breakers.end() || it->second.failures < m_BreakerThreshold) {
+            return true;
+        }
+
+        // Open: fail fast until the cooldown ends, then let a single probe
+        // through while everyone else keeps failing fast. A stream is never
+        // the probe: it would hold the slot for as long as it stays open
+        CircuitBreaker& breaker = it->second;
+        if (std::chrono::steady_clock::now() >= breaker.openUntil && !breaker.probing && !request.subscription) {
+            breaker.probing = true;
+            request.probe = true;
+            return true;
+        }
+
+        request.shortCircuited = true;
+        {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.shortCircuited++;
+        }
+        return false;
+    }
+
+    void BackgroundManager::RecordOutcome(const RequestData& request, bool failed) {
+        CircuitBreaker& breaker = m_Breakers[request.host];
+
+        if (!failed) {
+            if (breaker.failures >= m_BreakerThreshold) {
+                std::cout << "[BackgroundManager] Circuit closed for " << request.host << std::endl;
+            }
+            breaker.failures = 0;
 
-        if (progress && dltotal > 0) {
-            (*progress)(static_cast<size_t>(dlnow), static_cast<size_t>(dltotal));
+            auto elapsed = std::chrono::steady_clock::now() - request.attemptStart;
+            m_Latency[EndpointKey(request.options)].Add(std::chrono::duration<double>(elapsed).count());
+            return;
         }
 
-        return 0;
+        breaker.failures++;
+        if (breaker.failures >= m_BreakerThreshold) {
+            if (breaker.failures == m_BreakerThreshold || request.probe) {
+                std::cout << "[BackgroundManager] Circuit open for " << request.host << std::endl;
+            }
+            breaker.openUntil = std::chrono::steady_clock::now() +
+                std::chrono::seconds(m_BreakerCooldownSeconds.load());
+        }
     }
 
-    BackgroundManager& BackgroundManager::Get() {
-        static BackgroundManager instance;
-        return instance;
+    void BackgroundManager::SetCircuitBreaker(size_t failureThreshold, int cooldownSeconds) {
+        m_BreakerThreshold = std::max<size_t>(failureThreshold, 1);
+        m_BreakerCooldownSeconds = cooldownSeconds;
     }
 
-    void BackgroundManager::Init() {
-        curl_global_init(CURL_GLOBAL_ALL);
-        m_Running = true;
-        std::cout << "[BackgroundManager] Initialized" << std::endl;
-    }
+    // ============================================================================
+    // ADAPTIVE CONCURRENCY
+    // ============================================================================
 
-    void BackgroundManager::Shutdown() {
-        m_Running = false;
-        CancelAll();
+    ConcurrencyLimiter& BackgroundManager::HostLimiter(const std::string& host) {
+        auto [it, inserted] = m_HostLimits.try_emplace(host);
+        if (inserted) {
+            it->second.Configure(m_InitialConcurrency, m_MinConcurrency, m_MaxConcurrency, m_AdaptiveConcurrency);
+        }
+        return it->second;
+    }
 
-        for (auto& request : m_ActiveRequests) {
-            if (request->thread.joinable()) {
-                request->thread.join();
+    void BackgroundManager::RecordConcurrencySample(const RequestData& request, int curlResult, long statusCode) {
+        // Only answers that say "too much load" shrink the limit outright: a
+        // 429, a 503 that asks to come back later, or a timeout. Other
+        // failures (500, 502, 504, resets, refusals) are a flaky server, not
+        // a full one, and fewer requests would not fix them; an HTTP answer
+        // still counts as a latency sample, a connection that never produced
+        // one says nothing about the server's queue
+        CURLcode res = static_cast<CURLcode>(curlResult);
+        bool overloaded = res == CURLE_OPERATION_TIMEDOUT ||
+            (res == CURLE_OK && (statusCode == 429 ||
+                (statusCode == 503 && ResponseCache::FindHeader(request.responseHeaders, "Retry-After"))));
+        if (res != CURLE_OK && !overloaded) return;
+
+        auto elapsed = std::chrono::steady_clock::now() - request.attemptStart;
+
+        LimitDecision decision = LimitDecision::Hold;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            decision = HostLimiter(request.host).OnSample(std::chrono::duration<double>(elapsed).count(), overloaded);
+            if (decision == LimitDecision::Increase) {
+                m_QueueBlocked = false;
             }
         }
+        if (decision == LimitDecision::Hold) return;
 
-        m_ActiveRequests.clear();
-
-        while (!m_PendingRequests.empty()) {
-            m_PendingRequests.pop();
+        std::lock_guard<std::mutex> lock(m_StatsMutex);
+        if (decision == LimitDecision::Increase) {
+            m_Stats.limitIncreases++;
+        }
+        else {
+            m_Stats.limitDecreases++;
         }
-
-        curl_global_cleanup();
-        std::cout << "[BackgroundManager] Shutdown" << std::endl;
     }
 
-    BackgroundManager::~BackgroundManager() {
-        if (m_Running) {
-            Shutdown();
+    void BackgroundManager::SetConcurrencyLimit(size_t initial, size_t minimum, size_t maximum) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_MinConcurrency = std::max<size_t>(minimum, 1);
+            m_MaxConcurrency = std::max(maximum, m_MinConcurrency);
+            m_InitialConcurrency = std::clamp(initial, m_MinConcurrency, m_MaxConcurrency);
+
+            for (auto& [host, limiter] : m_HostLimits) {
+                limiter.Configure(m_InitialConcurrency, m_MinConcurrency, m_MaxConcurrency, m_AdaptiveConcurrency);
+            }
+            m_QueueBlocked = false;
         }
+        WakeIOThread();
     }
 
-    void BackgroundManager::Update() {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+    void BackgroundManager::SetAdaptiveConcurrency(bool enabled) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_AdaptiveConcurrency = enabled;
 
-        m_ActiveRequests.erase(
-            std::remove_if(m_ActiveRequests.begin(), m_ActiveRequests.end(),
-                [](const std::shared_ptr<RequestData>& req) {
-                    return req->handle->state != RequestState::Loading;
-                }),
-            m_ActiveRequests.end()
-        );
+            for (auto& [host, limiter] : m_HostLimits) {
+                limiter.Configure(m_InitialConcurrency, m_MinConcurrency, m_MaxConcurrency, m_AdaptiveConcurrency);
+            }
+            m_QueueBlocked = false;
+        }
+        WakeIOThread();
+    }
 
-        while (m_ActiveRequests.size() < m_MaxConcurrentRequests && !m_PendingRequests.empty()) {
-            auto request = m_PendingRequests.front();
-            m_PendingRequests.pop();
+    std::vector<HostConcurrency> BackgroundManager::GetConcurrencyLimits() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
 
-            ProcessRequest(request);
-            m_ActiveRequests.push_back(request);
+        std::vector<HostConcurrency> hosts;
+        hosts.reserve(m_HostLimits.size());
+        for (const auto& [host, limiter] : m_HostLimits) {
+            HostConcurrency entry;
+            entry.host = host;
+            entry.limit = limiter.Limit();
+            entry.inFlight = limiter.InFlight();
+            entry.adaptive = limiter.IsAdaptive();
+            entry.slowStart = limiter.InSlowStart();
+            entry.baselineLatency = limiter.BaselineLatency();
+            entry.recentLatency = limiter.RecentLatency();
+            entry.increases = limiter.Increases();
+            entry.latencyDecreases = limiter.LatencyDecreases();
+            entry.errorDecreases = limiter.ErrorDecreases();
+            entry.lastDecision = limiter.LastDecision();
+            hosts.push_back(std::move(entry));
         }
-    }
 
-    size_t BackgroundManager::Request(const RequestOptions& options, RequestCallback callback) {
-        return RequestWithProgress(options, callback, nullptr, nullptr);
+        std::sort(hosts.begin(), hosts.end(),
+            [](const HostConcurrency& a, const HostConcurrency& b) { return a.host < b.host; });
+        return hosts;
     }
 
-    size_t BackgroundManager::RequestWithProgress(const RequestOptions& options,
-        RequestCallback callback,
-        ProgressCallback downloadProgress,
-        UploadProgressCallback uploadProgress) {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+    // ============================================================================
+    // EVENT STREAMS
+    // ============================================================================
 
-        size_t requestId = m_NextRequestId++;
+    // Content-Type of an SSE response, parameters (charset) allowed
+    static bool IsEventStream(const std::string& contentType) {
+        const std::string_view expected = "text/event-stream";
+        if (contentType.size() < expected.size()) return false;
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(contentType[i])) != expected[i]) return false;
+        }
+        return contentType.size() == expected.size() || contentType[expected.size()] == ';' ||
+            contentType[expected.size()] == ' ';
+    }
 
-        auto handle = std::make_shared<RequestHandle>();
-        handle->id = requestId;
-        handle->state = RequestState::Idle;
-        handle->cancelled = false;
+    size_t BackgroundManager::Subscribe(const SubscriptionOptions& options, EventCallback onEvent,
+        SubscriptionCallback onState) {
+        auto subscription = std::make_shared<Subscription>();
+        subscription->id = m_NextSubscriptionId++;
+        subscription->options = options;
+        subscription->onEvent = std::move(onEvent);
+        subscription->onState = std::move(onState);
+        subscription->parser.SetLastEventId(options.lastEventId);
+        subscription->retryMs = std::max(options.reconnectDelayMs, 0);
+        subscription->deliveredId = options.lastEventId;
+        subscription->reconnectAt = std::chrono::steady_clock::now();
 
-        auto request = std::make_shared<RequestData>();
-        request->id = requestId;
-        request->options = options;
-        request->callback = callback;
-        request->downloadProgressCallback = downloadProgress;
-        request->uploadProgressCallback = uploadProgress;
-        request->handle = handle;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Subscriptions.push_back(subscription);
+        }
+        WakeIOThread();
+        return subscription->id;
+    }
 
-        m_Handles[requestId] = handle;
-        m_PendingRequests.push(request);
+    void BackgroundManager::Unsubscribe(size_t subscriptionId) {
+        size_t requestId = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = std::find_if(m_Subscriptions.begin(), m_Subscriptions.end(),
+                [&](const std::shared_ptr<Subscription>& subscription) { return subscription->id == subscriptionId; });
+            if (it == m_Subscriptions.end()) return;
 
-        if (callback) {
-            callback(RequestState::Idle, handle->response);
+            (*it)->closed = true;
+            requestId = (*it)->connectPending ? 0 : (*it)->requestId;
+            m_Subscriptions.erase(it);
         }
 
-        return requestId;
+        // Its end is not reported: closed subscriptions hear nothing more
+        if (requestId != 0) {
+            Cancel(requestId);
+        }
+    }
+
+    std::string BackgroundManager::GetLastEventId(size_t subscriptionId) const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (const auto& subscription : m_Subscriptions) {
+            if (subscription->id == subscriptionId) {
+                return subscription->deliveredId;
+            }
+        }
+        return {};
     }
 
-    void BackgroundManager::ProcessRequest(std::shared_ptr<RequestData> request) {
-        request->handle->state = RequestState::Loading;
+    void BackgroundManager::StartDueSubscriptions() {
+        std::vector<std::shared_ptr<Subscription>> due;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto now = std::chrono::steady_clock::now();
+            for (const auto& subscription : m_Subscriptions) {
+                if (subscription->connectPending && subscription->reconnectAt <= now) {
+                    subscription->connectPending = false;
+                    due.push_back(subscription);
+                }
+            }
+        }
 
-        if (request->callback) {
-            request->callback(RequestState::Loading, request->handle->response);
+        for (const auto& subscription : due) {
+            ConnectSubscription(subscription);
         }
+    }
 
-        request->thread = std::thread([this, request]() {
-            ExecuteRequest(request);
-            });
+    void BackgroundManager::ConnectSubscription(const std::shared_ptr<Subscription>& subscription) {
+        Subscription& stream = *subscription;
+        stream.parser.Reset();
+        stream.responseSeen = false;
+        stream.accepted = false;
 
-        request->thread.detach();
+        auto request = std::make_shared<RequestData>();
+        RequestOptions& options = request->options;
+        options.url = stream.options.url;
+        options.headers = stream.options.headers;
+        options.headers["Accept"] = "text/event-stream";
+        options.headers["Cache-Control"] = "no-cache";
+        if (!stream.parser.LastEventId().empty()) {
+            options.headers["Last-Event-ID"] = stream.parser.LastEventId();
+        }
+        options.timeoutSeconds = 0;
+        // An event must not sit in a compressor's buffer until more follow
+        options.useCompression = false;
+
+        // The callbacks live in the request, so they hold it by raw pointer
+        request->subscription = subscription;
+        request->chunkCallback = [this, raw = request.get()](std::string_view chunk) {
+            FeedSubscription(*raw, chunk);
+        };
+        request->callback = [this, subscription](RequestState state, const Response& response) {
+            OnSubscriptionEnded(subscription, state, response);
+        };
+
+        PostSubscriptionState(subscription, SubscriptionState::Connecting, "");
+        size_t requestId = Submit(request);
+
+        // Unsubscribed while connecting: either Unsubscribe sees this id or
+        // this sees the flag
+        bool closed = false;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            stream.requestId = requestId;
+            closed = stream.closed;
+        }
+        if (closed) {
+            Cancel(requestId);
+        }
     }
 
-    void BackgroundManager::ExecuteRequest(std::shared_ptr<RequestData> request) {
-        auto startTime = std::chrono::high_resolution_clock::now();
+    void BackgroundManager::FeedSubscription(RequestData& request, std::string_view chunk) {
+        const std::shared_ptr<Subscription>& subscription = request.subscription;
+        Subscription& stream = *subscription;
+        if (stream.closed) return;
 
-        CURL* curl = curl_easy_init();
-        if (!curl) {
-            request->handle->state = RequestState::Error;
-            request->handle->response.error = "Failed to initialize CURL";
+        if (!stream.responseSeen) {
+            // Headers are complete by the first body byte
+            stream.responseSeen = true;
 
-            if (request->callback) {
-                request->callback(RequestState::Error, request->handle->response);
+            long statusCode = 0;
+            curl_easy_getinfo(static_cast<CURL*>(request.easy), CURLINFO_RESPONSE_CODE, &statusCode);
+            const std::string* type = ResponseCache::FindHeader(request.responseHeaders, "Content-Type");
+            stream.accepted = statusCode == 200 && type && IsEventStream(*type);
+            if (!stream.accepted) return;
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                stream.failedAttempts = 0;
             }
-            return;
+            PostSubscriptionState(subscription, SubscriptionState::Open, "");
         }
 
-        std::string responseBody;
-        std::unordered_map<std::string, std::string> responseHeaders;
+        // An error page, not events
+        if (!stream.accepted) return;
+
+        static const Response s_NoResponse;
+        size_t events = 0;
+        stream.parser.Feed(chunk, [&](ServerEvent& event) {
+            events++;
+            PostCallback([this, subscription, event = std::move(event)](RequestState, const Response&) {
+                if (subscription->closed) return;
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    subscription->deliveredId = event.id;
+                }
+                if (subscription->onEvent) {
+                    subscription->onEvent(event);
+                }
+            }, RequestState::Success, s_NoResponse);
+        });
+
+        if (stream.parser.RetryMs() >= 0) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            stream.retryMs = stream.parser.RetryMs();
+        }
+        if (events > 0) {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.serverEvents += events;
+        }
+    }
 
-        curl_easy_setopt(curl, CURLOPT_URL, request->options.url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &responseHeaders);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, request->options.timeoutSeconds);
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, request->options.followRedirects ? 1L : 0L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    void BackgroundManager::OnSubscriptionEnded(const std::shared_ptr<Subscription>& subscription,
+        RequestState state, const Response& response) {
+        if (state == RequestState::Idle || state == RequestState::Queued || state == RequestState::Loading) return;
+        if (subscription->closed) return;
 
-        if (request->downloadProgressCallback) {
-            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, CurlProgressCallback);
-            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &request->downloadProgressCallback);
-            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        // The stream was accepted, so this is a drop (or the server ending
+        // the response); anything else was a failed attempt
+        bool accepted = subscription->accepted;
+        bool reconnect = true;
+        std::string error = response.error;
+
+        if (state == RequestState::Cancelled || response.statusCode == 204) {
+            reconnect = false;
+        }
+        else if (!accepted && response.statusCode != 0) {
+            const std::string* type = ResponseCache::FindHeader(response.headers, "Content-Type");
+            long status = response.statusCode;
+            if (status == 200 && !(type && IsEventStream(*type))) {
+                error = "Not an event stream";
+                reconnect = false;
+            }
+            else if (status != 200) {
+                error = "HTTP " + std::to_string(status);
+                reconnect = status == 408 || status == 429 || status >= 500;
+            }
         }
 
-        switch (request->options.method) {
-        case RequestMethod::POST:
-            curl_easy_setopt(curl, CURLOPT_POST, 1L);
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request->options.body.c_str());
-            break;
-        case RequestMethod::PUT:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request->options.body.c_str());
-            break;
-        case RequestMethod::HTTP_DELETE:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-            break;
-        case RequestMethod::PATCH:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request->options.body.c_str());
-            break;
-        default:
-            break;
+        if (!reconnect) {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                subscription->closed = true;
+                std::erase(m_Subscriptions, subscription);
+            }
+            if (subscription->onState) {
+                subscription->onState(SubscriptionState::Closed, error);
+            }
+            return;
         }
 
-        struct curl_slist* headers = nullptr;
-        for (const auto& [key, value] : request->options.headers) {
-            std::string header = key + ": " + value;
-            headers = curl_slist_append(headers, header.c_str());
+        // The server's retry time, doubled per failed attempt, with "equal
+        // jitter" so clients dropped together do not return together
+        static thread_local std::mt19937 random{ std::random_device{}() };
+        int64_t delayMs = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            int64_t base = std::max(subscription->retryMs, 1);
+            int64_t cap = std::max<int64_t>(subscription->options.maxReconnectDelayMs, base);
+            int64_t step = std::min(base << std::min(subscription->failedAttempts, 16), cap);
+            std::uniform_int_distribution<int64_t> jitter(step / 2, step);
+            delayMs = jitter(random);
+
+            if (!accepted) {
+                subscription->failedAttempts++;
+            }
+            subscription->connectPending = true;
+            subscription->reconnectAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
         }
-        if (headers) {
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.subscriptionReconnects++;
         }
 
-        CURLcode res = CURLE_OK;
-
-        if (!request->handle->cancelled) {
-            res = curl_easy_perform(curl);
-        }
-        else {
-            res = CURLE_ABORTED_BY_CALLBACK;
+        if (subscription->onState) {
+            subscription->onState(SubscriptionState::Reconnecting, error);
         }
+        WakeIOThread();
+    }
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    void BackgroundManager::PostSubscriptionState(const std::shared_ptr<Subscription>& subscription,
+        SubscriptionState state, const std::string& error) {
+        if (!subscription->onState) return;
 
-        request->handle->response.elapsedTime = duration.count() / 1000.0;
-        request->handle->response.body = responseBody;
-        request->handle->response.headers = responseHeaders;
+        static const Response s_NoResponse;
+        PostCallback([subscription, state, error](RequestState, const Response&) {
+            if (!subscription->closed) {
+                subscription->onState(state, error);
+            }
+        }, RequestState::Success, s_NoResponse);
+    }
 
-        double downloadSize = 0;
-        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &downloadSize);
-        request->handle->response.downloadSize = static_cast<size_t>(downloadSize);
+    // ============================================================================
+    // RESPONSE CACHE
+    // ============================================================================
+
+    std::string BackgroundManager::CacheKey(const RequestOptions& options) {
+        std::string key = "GET " + options.url;
+
+        // Request headers the representation may vary on. Credentials are
+        // hashed so tokens never end up in the disk cache.
+        for (std::string_view name : { "Accept", "Accept-Language", "Authorization" }) {
+            const std::string* value = ResponseCache::FindHeader(options.headers, name);
+            if (!value) continue;
+
+            key += '\n';
+            key += name;
+            key += ": ";
+            if (name == "Authorization") {
+                // FNV-1a, 64-bit
+                uint64_t hash = 14695981039346656037ull;
+                for (unsigned char c : *value) {
+                    hash ^= c;
+                    hash *= 1099511628211ull;
+                }
+                key += std::to_string(hash);
+            }
+            else {
+                key += *value;
+            }
+        }
 
-        double uploadSize = 0;
-        curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &uploadSize);
-        request->handle->response.uploadSize = static_cast<size_t>(uploadSize);
+        return key;
+    }
 
-        if (request->handle->cancelled) {
-            request->handle->state = RequestState::Cancelled;
-            request->handle->response.error = "Request cancelled";
+    bool BackgroundManager::ApplyCachePolicy(const std::shared_ptr<RequestData>& request) {
+        RequestOptions& options = request->options;
+        if (options.cachePolicy == CachePolicy::NoCache || options.method != RequestMethod::GET ||
+            request->chunkCallback) {
+            return false;
         }
-        else if (res != CURLE_OK) {
-            request->handle->state = RequestState::Error;
-            request->handle->response.error = curl_easy_strerror(res);
+
+        request->cacheKey = CacheKey(options);
+
+        Response cached;
+        CacheValidators validators;
+        bool found = m_ResponseCache->Lookup(request->cacheKey, cached, validators);
+
+        // Not in memory yet this run: promote the copy from disk, aged by
+        // the time since it was stored so freshness stays correct
+        int64_t ageSeconds = 0;
+        if (!found && m_DiskCache->Load(request->cacheKey, cached, ageSeconds)) {
+            m_ResponseCache->Store(request->cacheKey, cached, ageSeconds);
+            found = m_ResponseCache->Lookup(request->cacheKey, cached, validators);
         }
-        else {
-            long statusCode = 0;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
-            request->handle->response.statusCode = static_cast<int>(statusCode);
 
-            if (statusCode >= 200 && statusCode < 300) {
-                request->handle->state = RequestState::Success;
+        bool answer = options.cachePolicy == CachePolicy::CacheOnly ||
+            (options.cachePolicy == CachePolicy::CacheFirst && found && validators.fresh);
+
+        if (answer) {
+            Response response;
+            RequestState state = RequestState::Success;
+            if (found) {
+                response = std::move(cached);
+                response.fromCache = true;
+                response.elapsedTime = 0.0;
             }
             else {
-                request->handle->state = RequestState::Error;
-                request->handle->response.error = "HTTP " + std::to_string(statusCode);
+                response.error = "Not in cache";
+                state = RequestState::Error;
             }
-        }
 
-        if (headers) {
-            curl_slist_free_all(headers);
-        }
-
-        curl_easy_cleanup(curl);
-
-        if (request->callback) {
-            request->callback(request->handle->state, request->handle->response);
+            DeliverResult(request, std::move(response), state);
+            return true;
         }
 
-        UpdateStats(request->handle->response, request->handle->state);
+        if (found) {
+            // Conditional request; the caller's own validators take precedence
+            if (!validators.etag.empty()) {
+                options.headers.try_emplace("If-None-Match", validators.etag);
+            }
+            if (!validators.lastModified.empty()) {
+                options.headers.try_emplace("If-Modified-Since", validators.lastModified);
+            }
 
-        {
-            std::lock_guard<std::mutex> lock(m_Mutex);
-            std::string historyEntry = request->options.url + " - " +
-                std::to_string(request->handle->response.statusCode) + " - " +
-                std::to_string(static_cast<int>(request->handle->response.elapsedTime * 1000)) + "ms";
-            m_RequestHistory.push_back(historyEntry);
+            request->cachedResponse = std::move(cached);
+            request->hasCachedResponse = true;
 
-            if (m_RequestHistory.size() > 100) {
-                m_RequestHistory.erase(m_RequestHistory.begin());
+            // Show the last known data now; the transfer delivers again
+            if (options.staleWhileRevalidate && request->callback) {
+                Response stale = request->cachedResponse;
+                stale.fromCache = true;
+                stale.stale = true;
+                stale.elapsedTime = 0.0;
+                PostCallback(request->callback, RequestState::Success, stale);
             }
         }
+
+        return false;
     }
 
     void BackgroundManager::Cancel(size_t requestId) {
@@ -302,14 +1844,46 @@ namespace Unicorn::Background {
         if (it != m_Handles.end()) {
             it->second->cancelled = true;
         }
+        WakeIOThread();
     }
 
     void BackgroundManager::CancelAll() {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            for (auto& [id, handle] : m_Handles) {
+                handle->cancelled = true;
+            }
+        }
+        WakeIOThread();
+    }
+
+    bool BackgroundManager::SetPriority(size_t requestId, RequestPriority priority) {
+        bool moved = false;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            // The request itself, or the queued transfer it is waiting on;
+            // a shared transfer is only ever promoted
+            moved = m_PendingRequests.Reprioritize([&](const std::shared_ptr<RequestData>& pending) {
+                if (pending->id == requestId) {
+                    pending->priority = priority;
+                    return true;
+                }
+                bool follows = std::any_of(pending->followers.begin(), pending->followers.end(),
+                    [&](const std::shared_ptr<RequestData>& follower) { return follower->id == requestId; });
+                if (follows && priority < pending->priority) {
+                    pending->priority = priority;
+                    return true;
+                }
+                return false;
+            }, static_cast<size_t>(priority));
+        }
 
-        for (auto& [id, handle] : m_Handles) {
-            handle->cancelled = true;
+        if (moved) {
+            WakeIOThread();
         }
+        return moved;
     }
 
     RequestState BackgroundManager::GetState(size_t requestId) const {
@@ -341,11 +1915,30 @@ namespace Unicorn::Background {
 
     size_t BackgroundManager::GetPendingRequestCount() const {
         std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_PendingRequests.size();
+        return m_PendingRequests.Size();
+    }
+
+    void BackgroundManager::SetPriorityAging(int milliseconds) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_PendingRequests.SetAgingStep(std::chrono::milliseconds(milliseconds));
+    }
+
+    void BackgroundManager::SetMaxConnectionsPerHost(size_t max) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_MaxConnectionsPerHost = max;
+            m_QueueBlocked = false;
+        }
+        WakeIOThread();
     }
 
-    void BackgroundManager::SetMaxConcurrentRequests(size_t max) {
-        m_MaxConcurrentRequests = max;
+    void BackgroundManager::SetMaxConcurrentStreams(size_t max) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_MaxConcurrentStreams = std::max<size_t>(max, 1);
+            m_QueueBlocked = false;
+        }
+        WakeIOThread();
     }
 
     void BackgroundManager::SetGlobalTimeout(int seconds) {
@@ -363,17 +1956,23 @@ namespace Unicorn::Background {
     }
 
     void BackgroundManager::ClearCache() {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        m_Cache.clear();
+        // Both stores: a disk entry left behind would be promoted straight
+        // back into memory by the next lookup
+        m_ResponseCache->Clear();
+        m_DiskCache->Clear();
     }
 
     void BackgroundManager::SetCacheMaxSize(size_t maxSizeMB) {
-        m_CacheMaxSize = maxSizeMB;
+        m_ResponseCache->SetMaxBytes(maxSizeMB * 1024 * 1024);
     }
 
-    bool BackgroundManager::IsCached(const std::string& url) const {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Cache.find(url) != m_Cache.end();
+    void BackgroundManager::SetDiskCacheMaxSize(size_t maxSizeMB) {
+        m_DiskCache->SetMaxBytes(maxSizeMB * 1024 * 1024);
+    }
+
+    bool BackgroundManager::IsCached(const RequestOptions& options) const {
+        std::string key = CacheKey(options);
+        return m_ResponseCache->Contains(key) || m_DiskCache->Contains(key);
     }
 
     std::string BackgroundManager::BuildQueryString(const std::unordered_map<std::string, std::string>& params) {
@@ -431,6 +2030,9 @@ namespace Unicorn::Background {
         CURL* curl = curl_easy_init();
         if (!curl) return false;
 
+        if (m_Share) {
+            curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH*>(m_Share));
+        }
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeoutSeconds);
@@ -446,20 +2048,272 @@ namespace Unicorn::Background {
         return (res == CURLE_OK && response_code >= 200 && response_code < 400);
     }
 
-    std::vector<std::string> BackgroundManager::GetRequestHistory(size_t maxCount) const {
+    // ============================================================================
+    // METRICS
+    // ============================================================================
+
+    void BackgroundManager::RecordHistory(const RequestData& request, const Response& response,
+        RequestState state) {
+        RequestRecord record;
+        record.id = request.id;
+        record.method = request.options.method;
+        record.url = request.options.url;
+        record.state = state;
+        record.statusCode = response.statusCode;
+        record.elapsedTime = response.elapsedTime;
+        record.timing = response.timing;
+        record.downloadSize = response.downloadSize;
+        record.decodedDownloadSize = response.decodedDownloadSize;
+        record.httpVersion = response.httpVersion;
+        record.retries = request.handle->currentRetry;
+        record.fromCache = response.fromCache;
+        record.revalidated = response.revalidated;
+        record.hedged = request.hedgeWon;
+        record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        // Only answers that went over the network describe the endpoint; a
+        // stream's duration is how long it stayed open, not a latency
+        bool network = !request.subscription && response.statusCode != 0 &&
+            (!response.fromCache || response.revalidated);
+        if (network) {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            EndpointMetrics& metrics = m_Endpoints[EndpointKey(request.options)];
+            metrics.latency.Record(response.elapsedTime);
+            metrics.timingSum.dns += response.timing.dns;
+            metrics.timingSum.connect += response.timing.connect;
+            metrics.timingSum.tls += response.timing.tls;
+            metrics.timingSum.wait += response.timing.wait;
+            metrics.timingSum.download += response.timing.download;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_History.size() < s_HistorySize) {
+            m_History.push_back(std::move(record));
+        }
+        else {
+            m_History[m_HistoryNext] = std::move(record);
+        }
+        m_HistoryNext = (m_HistoryNext + 1) % s_HistorySize;
+    }
+
+    std::vector<RequestRecord> BackgroundManager::GetRequestHistory(size_t maxCount) const {
         std::lock_guard<std::mutex> lock(m_Mutex);
 
-        if (maxCount == 0) {
-            return {};
+        size_t count = std::min(maxCount, m_History.size());
+        std::vector<RequestRecord> records;
+        records.reserve(count);
+
+        // m_HistoryNext is the oldest slot once the ring is full
+        size_t newest = (m_HistoryNext + s_HistorySize - 1) % s_HistorySize;
+        for (size_t i = count; i > 0; i--) {
+            size_t slot = (newest + s_HistorySize - (i - 1)) % s_HistorySize;
+            records.push_back(m_History[slot]);
+        }
+        return records;
+    }
+
+    void BackgroundManager::ClearRequestHistory() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_History.clear();
+        m_HistoryNext = 0;
+    }
+
+    std::vector<EndpointLatency> BackgroundManager::GetEndpointLatencies() const {
+        std::lock_guard<std::mutex> lock(m_StatsMutex);
+
+        std::vector<EndpointLatency> endpoints;
+        endpoints.reserve(m_Endpoints.size());
+        for (const auto& [key, metrics] : m_Endpoints) {
+            const LatencyHistogram& latency = metrics.latency;
+            double count = static_cast<double>(std::max<size_t>(latency.Count(), 1));
+
+            EndpointLatency endpoint;
+            endpoint.endpoint = key;
+            endpoint.count = latency.Count();
+            endpoint.p50 = latency.Percentile(50.0);
+            endpoint.p95 = latency.Percentile(95.0);
+            endpoint.p99 = latency.Percentile(99.0);
+            endpoint.max = latency.Max();
+            endpoint.mean = latency.Mean();
+            endpoint.meanTiming.dns = metrics.timingSum.dns / count;
+            endpoint.meanTiming.connect = metrics.timingSum.connect / count;
+            endpoint.meanTiming.tls = metrics.timingSum.tls / count;
+            endpoint.meanTiming.wait = metrics.timingSum.wait / count;
+            endpoint.meanTiming.download = metrics.timingSum.download / count;
+            endpoints.push_back(std::move(endpoint));
+        }
+
+        std::sort(endpoints.begin(), endpoints.end(),
+            [](const EndpointLatency& a, const EndpointLatency& b) { return a.count > b.count; });
+        return endpoints;
+    }
+
+    static void AppendJsonString(std::string& out, std::string_view value) {
+        static const char hexChars[] = "0123456789abcdef";
+
+        out += '"';
+        for (unsigned char c : value) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += hexChars[c >> 4];
+                    out += hexChars[c & 0xF];
+                }
+                else {
+                    out += static_cast<char>(c);
+                }
+            }
+        }
+        out += '"';
+    }
+
+    static void AppendJsonMs(std::string& out, const char* name, double seconds) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "\"%s\":%.3f", name, seconds * 1000.0);
+        out += buffer;
+    }
+
+    static void AppendJsonTiming(std::string& out, const RequestTiming& timing) {
+        out += "{";
+        AppendJsonMs(out, "dnsMs", timing.dns);
+        out += ',';
+        AppendJsonMs(out, "connectMs", timing.connect);
+        out += ',';
+        AppendJsonMs(out, "tlsMs", timing.tls);
+        out += ',';
+        AppendJsonMs(out, "waitMs", timing.wait);
+        out += ',';
+        AppendJsonMs(out, "downloadMs", timing.download);
+        out += "}";
+    }
+
+    std::string BackgroundManager::ExportMetricsJson() const {
+        static const char* states[] = { "idle", "queued", "loading", "success", "error", "cancelled", "timeout" };
+        static const char* methods[] = { "GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "OPTIONS" };
+
+        RequestStats stats = GetStats();
+        std::vector<EndpointLatency> endpoints = GetEndpointLatencies();
+        std::vector<RequestRecord> history = GetRequestHistory(s_HistorySize);
+
+        std::string json;
+        json.reserve(1024 + endpoints.size() * 256 + history.size() * 320);
+
+        // Every RequestStats field, in declaration order, so the export adds
+        // up to what the API Testing page shows
+        char reuseRate[32];
+        std::snprintf(reuseRate, sizeof(reuseRate), "%.4f", stats.connectionReuseRate);
+
+        json += "{\n  \"stats\": {";
+        json += "\"totalRequests\":" + std::to_string(stats.totalRequests);
+        json += ",\"successfulRequests\":" + std::to_string(stats.successfulRequests);
+        json += ",\"failedRequests\":" + std::to_string(stats.failedRequests);
+        json += ",\"cancelledRequests\":" + std::to_string(stats.cancelledRequests);
+        json += ',';
+        AppendJsonMs(json, "averageResponseMs", stats.averageResponseTime);
+        json += ",\"bytesDownloaded\":" + std::to_string(stats.totalBytesDownloaded);
+        json += ",\"bytesUploaded\":" + std::to_string(stats.totalBytesUploaded);
+        json += ",\"bytesDecoded\":" + std::to_string(stats.totalBytesDecoded);
+        json += ",\"bytesUploadedRaw\":" + std::to_string(stats.totalBytesUploadedRaw);
+        json += ",\"cacheHits\":" + std::to_string(stats.cacheHits);
+        json += ",\"cacheMisses\":" + std::to_string(stats.cacheMisses);
+        json += ",\"notModified\":" + std::to_string(stats.notModified);
+        json += ",\"coalescedRequests\":" + std::to_string(stats.coalescedRequests);
+        json += ",\"reusedConnections\":" + std::to_string(stats.reusedConnections);
+        json += ",\"newConnections\":" + std::to_string(stats.newConnections);
+        json += ",\"connectionReuseRate\":";
+        json += reuseRate;
+        json += ",\"multiplexedRequests\":" + std::to_string(stats.multiplexedRequests);
+        json += ",\"retries\":" + std::to_string(stats.retries);
+        json += ",\"hedgedRequests\":" + std::to_string(stats.hedgedRequests);
+        json += ",\"hedgeWins\":" + std::to_string(stats.hedgeWins);
+        json += ",\"shortCircuited\":" + std::to_string(stats.shortCircuited);
+        json += ",\"limitIncreases\":" + std::to_string(stats.limitIncreases);
+        json += ",\"limitDecreases\":" + std::to_string(stats.limitDecreases);
+        json += ",\"serverEvents\":" + std::to_string(stats.serverEvents);
+        json += ",\"subscriptionReconnects\":" + std::to_string(stats.subscriptionReconnects);
+        json += "},\n  \"concurrency\": [";
+
+        std::vector<HostConcurrency> hosts = GetConcurrencyLimits();
+        for (size_t i = 0; i < hosts.size(); i++) {
+            static const char* decisions[] = { "hold", "increase", "decreaseLatency", "decreaseErrors" };
+            const HostConcurrency& host = hosts[i];
+            json += i == 0 ? "\n    {" : ",\n    {";
+            json += "\"host\":";
+            AppendJsonString(json, host.host);
+            json += ",\"limit\":" + std::to_string(host.limit);
+            json += ",\"inFlight\":" + std::to_string(host.inFlight);
+            json += std::string(",\"adaptive\":") + (host.adaptive ? "true" : "false");
+            json += std::string(",\"slowStart\":") + (host.slowStart ? "true" : "false");
+            json += ',';
+            AppendJsonMs(json, "baselineMs", host.baselineLatency);
+            json += ',';
+            AppendJsonMs(json, "recentMs", host.recentLatency);
+            json += ",\"increases\":" + std::to_string(host.increases);
+            json += ",\"latencyDecreases\":" + std::to_string(host.latencyDecreases);
+            json += ",\"errorDecreases\":" + std::to_string(host.errorDecreases);
+            json += ",\"lastDecision\":\"";
+            json += decisions[static_cast<int>(host.lastDecision)];
+            json += "\"}";
+        }
+
+        json += hosts.empty() ? "],\n  \"endpoints\": [" : "\n  ],\n  \"endpoints\": [";
+
+        for (size_t i = 0; i < endpoints.size(); i++) {
+            const EndpointLatency& endpoint = endpoints[i];
+            json += i == 0 ? "\n    {" : ",\n    {";
+            json += "\"endpoint\":";
+            AppendJsonString(json, endpoint.endpoint);
+            json += ",\"count\":" + std::to_string(endpoint.count) + ',';
+            AppendJsonMs(json, "p50Ms", endpoint.p50);
+            json += ',';
+            AppendJsonMs(json, "p95Ms", endpoint.p95);
+            json += ',';
+            AppendJsonMs(json, "p99Ms", endpoint.p99);
+            json += ',';
+            AppendJsonMs(json, "maxMs", endpoint.max);
+            json += ',';
+            AppendJsonMs(json, "meanMs", endpoint.mean);
+            json += ",\"meanTiming\":";
+            AppendJsonTiming(json, endpoint.meanTiming);
+            json += '}';
         }
 
-        size_t startIdx = m_RequestHistory.size() > maxCount ?
-            m_RequestHistory.size() - maxCount : 0;
+        json += endpoints.empty() ? "],\n  \"history\": [" : "\n  ],\n  \"history\": [";
+
+        for (size_t i = 0; i < history.size(); i++) {
+            const RequestRecord& record = history[i];
+            json += i == 0 ? "\n    {" : ",\n    {";
+            json += "\"id\":" + std::to_string(record.id);
+            json += ",\"method\":\"";
+            json += methods[static_cast<int>(record.method)];
+            json += "\",\"url\":";
+            AppendJsonString(json, record.url);
+            json += ",\"state\":\"";
+            json += states[static_cast<int>(record.state)];
+            json += "\",\"status\":" + std::to_string(record.statusCode) + ',';
+            AppendJsonMs(json, "elapsedMs", record.elapsedTime);
+            json += ",\"timing\":";
+            AppendJsonTiming(json, record.timing);
+            json += ",\"bytes\":" + std::to_string(record.downloadSize);
+            json += ",\"decodedBytes\":" + std::to_string(record.decodedDownloadSize);
+            json += ",\"httpVersion\":" + std::to_string(record.httpVersion);
+            json += ",\"retries\":" + std::to_string(record.retries);
+            json += std::string(",\"fromCache\":") + (record.fromCache ? "true" : "false");
+            json += std::string(",\"revalidated\":") + (record.revalidated ? "true" : "false");
+            json += std::string(",\"hedged\":") + (record.hedged ? "true" : "false");
+            json += ",\"timestamp\":" + std::to_string(record.timestamp);
+            json += '}';
+        }
 
-        return std::vector<std::string>(
-            m_RequestHistory.begin() + static_cast<std::ptrdiff_t>(startIdx),
-            m_RequestHistory.end()
-        );
+        json += history.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return json;
     }
 
     RequestStats BackgroundManager::GetStats() const {
@@ -467,7 +2321,7 @@ namespace Unicorn::Background {
         return m_Stats;
     }
 
-    void BackgroundManager::UpdateStats(const Response& response, RequestState state) {
+    void BackgroundManager::UpdateStats(const Response& response, RequestState state, bool timed) {
         std::lock_guard<std::mutex> lock(m_StatsMutex);
 
         m_Stats.totalRequests++;
@@ -488,12 +2342,37 @@ namespace Unicorn::Background {
         }
 
         if (state == RequestState::Success) {
-            double totalTime = m_Stats.averageResponseTime * (m_Stats.successfulRequests - 1);
-            m_Stats.averageResponseTime = (totalTime + response.elapsedTime) / m_Stats.successfulRequests;
+            if (timed) {
+                m_TimedResponses++;
+                double totalTime = m_Stats.averageResponseTime * static_cast<double>(m_TimedResponses - 1);
+                m_Stats.averageResponseTime = (totalTime + response.elapsedTime) / static_cast<double>(m_TimedResponses);
+            }
+
+            if (!response.coalesced) {
+                m_Stats.totalBytesDownloaded += response.downloadSize;
+                m_Stats.totalBytesUploaded += response.uploadSize;
+                m_Stats.totalBytesDecoded += response.decodedDownloadSize;
+                m_Stats.totalBytesUploadedRaw += response.rawUploadSize;
+            }
 
-            m_Stats.totalBytesDownloaded += response.downloadSize;
-            m_Stats.totalBytesUploaded += response.uploadSize;
+            if (!response.coalesced && (!response.fromCache || response.revalidated)) {
+                if (response.reusedConnection) {
+                    m_Stats.reusedConnections++;
+                }
+                else {
+                    m_Stats.newConnections++;
+                }
+                m_Stats.connectionReuseRate = static_cast<double>(m_Stats.reusedConnections) /
+                    static_cast<double>(m_Stats.reusedConnections + m_Stats.newConnections);
+
+                if (response.httpVersion >= 20) {
+                    m_Stats.multiplexedRequests++;
+                }
+            }
 
+            if (response.revalidated) {
+                m_Stats.notModified++;
+            }
             if (response.fromCache) {
                 m_Stats.cacheHits++;
             }
@@ -503,61 +2382,14 @@ namespace Unicorn::Background {
         }
     }
 
-    bool BackgroundManager::GetCachedResponse(const std::string& url, Response& response) {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-
-        auto it = m_Cache.find(url);
-        if (it != m_Cache.end()) {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(
-                now - it->second.timestamp
-            ).count();
-
-            if (elapsed < 60) {
-                response = it->second.response;
-                response.fromCache = true;
-                it->second.accessCount++;
-                return true;
-            }
-            else {
-                m_Cache.erase(it);
-            }
-        }
-
-        return false;
-    }
-
-    void BackgroundManager::CacheResponse(const std::string& url, const Response& response) {
+    void BackgroundManager::CompleteRequest(size_t requestId) {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        m_FinishedHandles.push_back(requestId);
 
-        if (m_Cache.size() >= m_CacheMaxSize) {
-            CleanupCache();
-        }
-
-        CachedResponse cached;
-        cached.response = response;
-        cached.timestamp = std::chrono::steady_clock::now();
-        cached.accessCount = 0;
-
-        m_Cache[url] = cached;
-    }
-
-    void BackgroundManager::CleanupCache() {
-        if (m_Cache.empty()) return;
-
-        auto oldest = m_Cache.begin();
-        for (auto it = m_Cache.begin(); it != m_Cache.end(); ++it) {
-            if (it->second.timestamp < oldest->second.timestamp) {
-                oldest = it;
-            }
+        while (m_FinishedHandles.size() > s_MaxFinishedHandles) {
+            m_Handles.erase(m_FinishedHandles.front());
+            m_FinishedHandles.pop_front();
         }
-
-        m_Cache.erase(oldest);
-    }
-
-    void BackgroundManager::CompleteRequest(size_t requestId) {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        m_Handles.erase(requestId);
     }
 
 } // namespace Unicorn::Background
\ No newline at end of file
@@ -8,11 +8,23 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <chrono>
+#include <random>
+#include <unordered_set>
+#include <cstdint>
+#include "completion_queue.h"
+#include "body_buffer.h"
+#include "request_scheduler.h"
+#include "latency_histogram.h"
+#include "concurrency_limiter.h"
+#include "sse_parser.h"
 
 namespace Unicorn::Background {
 
+    class ResponseCache;
+    class ResponseDiskCache;
+
     enum class RequestState {
         Idle,
         Queued,
@@ -33,6 +45,30 @@ namespace Unicorn::Background {
         OPTIONS
     };
 
+    // Order in which queued requests get a transfer slot: something the user
+    // is waiting on, data for what is on screen, data for where the user is
+    // likely to go next, background sync. Queued requests age towards
+    // Interactive, so every class is eventually served.
+    enum class RequestPriority {
+        Interactive,
+        Visible,
+        Prefetch,
+        Bulk
+    };
+
+    // Auto speaks HTTP/2 to HTTPS servers that offer it (ALPN) and HTTP/1.1
+    // otherwise. Http2PriorKnowledge talks HTTP/2 over cleartext without an
+    // upgrade, for local servers that only speak h2c.
+    enum class HttpVersion {
+        Auto,
+        Http1,
+        Http2PriorKnowledge
+    };
+
+    // Applies to GET requests. CacheFirst answers from a fresh entry without
+    // touching the network, NetworkFirst always asks the server but falls
+    // back to the cache when it cannot be reached, CacheOnly never goes to
+    // the network. Stale entries with validators are revalidated (304).
     enum class CachePolicy {
         NoCache,
         CacheFirst,
@@ -50,20 +86,58 @@ namespace Unicorn::Background {
         bool verifySSL = true;
         int maxRedirects = 5;
         CachePolicy cachePolicy = CachePolicy::NoCache;
+        RequestPriority priority = RequestPriority::Visible;
+        // With a cache policy: a stale cached copy (e.g. from the previous
+        // run) is delivered right away as Success with Response::stale set,
+        // then the callback fires again once revalidation finishes
+        bool staleWhileRevalidate = false;
+        // Idempotent methods only: transient failures (connect errors,
+        // timeouts, 408/429/502/503/504) are retried after retryDelayMs,
+        // doubled per attempt with jitter (Retry-After is honoured)
         int retryCount = 0;
         int retryDelayMs = 1000;
+        // GET/HEAD: once the request runs longer than this percentile of the
+        // endpoint's recent latency, a duplicate is sent and the first usable
+        // answer wins
+        bool hedge = false;
+        double hedgePercentile = 95.0;
+        // Negotiate compressed responses (Accept-Encoding); bodies are
+        // decoded transparently before they reach the caller
         bool useCompression = true;
+        // POST/PUT/PATCH bodies of at least 1 KB are sent gzip-encoded
+        // (Content-Encoding: gzip); the server must accept that. Compressed
+        // once, on the calling thread.
+        bool compressBody = false;
+        HttpVersion httpVersion = HttpVersion::Auto;
+    };
+
+    // Where a transfer's time went, in seconds. Phases a reused connection
+    // skips (DNS, connect, TLS) are zero.
+    struct RequestTiming {
+        double dns = 0.0;
+        double connect = 0.0;       // TCP handshake
+        double tls = 0.0;           // TLS handshake
+        double wait = 0.0;          // Request sent to first response byte
+        double download = 0.0;      // First to last byte
     };
 
     struct Response {
         int statusCode = 0;
-        std::string body;
+        BodyView body;                  // Shared with every copy of the response
         std::unordered_map<std::string, std::string> headers;
         std::string error;
         double elapsedTime = 0.0;
-        size_t downloadSize = 0;
-        size_t uploadSize = 0;
+        size_t downloadSize = 0;        // Body bytes on the wire (compressed if encoded)
+        size_t decodedDownloadSize = 0; // ... after content decoding
+        size_t uploadSize = 0;          // Body bytes sent
+        size_t rawUploadSize = 0;       // ... before gzip
         bool fromCache = false;
+        bool revalidated = false;       // 304 Not Modified: body served from cache
+        bool stale = false;             // Early stale-while-revalidate delivery
+        bool coalesced = false;         // Shared an identical request's transfer
+        bool reusedConnection = false;  // No new TCP/TLS connection was opened
+        int httpVersion = 0;            // 11 for HTTP/1.1, 20 for HTTP/2; 0 without a response
+        RequestTiming timing;           // Of the last network attempt
     };
 
     struct RequestStats {
@@ -72,15 +146,102 @@ namespace Unicorn::Background {
         size_t failedRequests = 0;
         size_t cancelledRequests = 0;
         double averageResponseTime = 0.0;
-        size_t totalBytesDownloaded = 0;
+        size_t totalBytesDownloaded = 0;    // On the wire
         size_t totalBytesUploaded = 0;
+        size_t totalBytesDecoded = 0;       // Downloads after decoding
+        size_t totalBytesUploadedRaw = 0;   // Uploads before compression
         size_t cacheHits = 0;
         size_t cacheMisses = 0;
+        size_t notModified = 0;             // Revalidations answered with 304
+        size_t coalescedRequests = 0;       // Identical GETs merged into an in-flight transfer
+        size_t reusedConnections = 0;
+        size_t newConnections = 0;
+        double connectionReuseRate = 0.0;   // reused / (reused + new)
+        size_t multiplexedRequests = 0;     // Answered over HTTP/2 or later
+        size_t retries = 0;
+        size_t hedgedRequests = 0;          // Duplicates sent for slow requests
+        size_t hedgeWins = 0;               // ... that answered first
+        size_t shortCircuited = 0;          // Failed fast on an open circuit
+        size_t limitIncreases = 0;          // Adaptive concurrency decisions, all hosts
+        size_t limitDecreases = 0;
+        size_t serverEvents = 0;            // Delivered to subscribers
+        size_t subscriptionReconnects = 0;
+    };
+
+    // One finished request, as kept in the history ring
+    struct RequestRecord {
+        size_t id = 0;
+        RequestMethod method = RequestMethod::GET;
+        std::string url;
+        RequestState state = RequestState::Idle;
+        int statusCode = 0;
+        double elapsedTime = 0.0;
+        RequestTiming timing;
+        size_t downloadSize = 0;
+        size_t decodedDownloadSize = 0;
+        int httpVersion = 0;
+        int retries = 0;
+        bool fromCache = false;
+        bool revalidated = false;
+        bool hedged = false;            // Answered by the duplicate transfer
+        int64_t timestamp = 0;          // Unix time, milliseconds
+    };
+
+    // Latency of one endpoint (method + URL without query) over the session
+    struct EndpointLatency {
+        std::string endpoint;
+        size_t count = 0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+        RequestTiming meanTiming;
+    };
+
+    // Adaptive concurrency state of one host
+    struct HostConcurrency {
+        std::string host;
+        size_t limit = 0;
+        size_t inFlight = 0;
+        bool adaptive = true;
+        bool slowStart = true;
+        double baselineLatency = 0.0;   // Seconds
+        double recentLatency = 0.0;
+        size_t increases = 0;
+        size_t latencyDecreases = 0;
+        size_t errorDecreases = 0;
+        LimitDecision lastDecision = LimitDecision::Hold;
+    };
+
+    // Connection state of a Subscribe() stream
+    enum class SubscriptionState {
+        Connecting,
+        Open,               // Response accepted, events flowing
+        Reconnecting,       // Dropped; the next attempt is scheduled
+        Closed              // Ended by the server (204, 4xx) or by a cancel
+    };
+
+    struct SubscriptionOptions {
+        std::string url;
+        std::unordered_map<std::string, std::string> headers;    // e.g. Authorization
+        std::string lastEventId;        // Resume after this event, e.g. from the previous session
+        int reconnectDelayMs = 3000;    // Until the server sends "retry:"
+        int maxReconnectDelayMs = 30000;    // Backoff cap while reconnects keep failing
+        // No bytes for this long (events or keep-alive comments) counts as
+        // a dead connection
+        int idleTimeoutSeconds = 90;
     };
 
     using RequestCallback = std::function<void(RequestState state, const Response& response)>;
+    // On the UI thread like RequestCallback; a fast transfer is reported at
+    // most once per Update() with the latest byte counts
     using ProgressCallback = std::function<void(size_t current, size_t total)>;
     using UploadProgressCallback = std::function<void(size_t uploaded, size_t total)>;
+    // Body bytes as they arrive, on the I/O thread; must not touch UI state
+    using ChunkCallback = std::function<void(std::string_view chunk)>;
+    using EventCallback = std::function<void(const ServerEvent& event)>;
+    using SubscriptionCallback = std::function<void(SubscriptionState state, const std::string& error)>;
 
     struct RequestHandle {
         size_t id;
@@ -91,12 +252,38 @@ namespace Unicorn::Background {
         int currentRetry = 0;
     };
 
+    // HTTP client for the app. All transfers run on one I/O thread driving a
+    // curl multi handle, so a burst of requests costs no thread creation and
+    // Shutdown can join cleanly. Callbacks run on the UI thread: the I/O
+    // thread queues them and Update() dispatches each batch (the Idle
+    // callback runs inside Request() on the calling thread).
+    //
+    // Easy handles are pooled per host and every handle is attached to one
+    // share object (DNS, TLS sessions, connections), so repeated calls to the
+    // same backend skip the TCP and TLS handshakes.
+    //
+    // Identical GET/HEAD requests issued while one is in flight ride on that
+    // transfer: every caller keeps its own id and callback and can cancel on
+    // its own, and the transfer is only aborted once nobody is waiting.
+    //
+    // Once a host has answered over HTTP/2, its requests become streams on
+    // one shared connection, so a fan-out of hundreds of GETs is not bounded
+    // by the connection count.
+    //
+    // How many requests a host gets at once is decided per host by a
+    // ConcurrencyLimiter from the latency and overload answers it sees,
+    // between SetConcurrencyLimit's bounds and never above what the
+    // transport allows (SetMaxConnectionsPerHost, or SetMaxConcurrentStreams
+    // for HTTP/2 hosts).
     class BackgroundManager {
     public:
         static BackgroundManager& Get();
 
         void Init();
         void Shutdown();
+
+        // UI thread, once per frame: run queued callbacks and request one
+        // redraw if there were any
         void Update();
 
         size_t Request(const RequestOptions& options, RequestCallback callback);
@@ -106,78 +293,339 @@ namespace Unicorn::Background {
             ProgressCallback downloadProgress,
             UploadProgressCallback uploadProgress = nullptr);
 
+        // For consumers that parse incrementally: the body is handed to
+        // onChunk and not retained, so the final Response has an empty body.
+        // Streaming requests bypass the cache and are never coalesced.
+        size_t RequestStreaming(const RequestOptions& options,
+            ChunkCallback onChunk,
+            RequestCallback callback);
+
+        // Server-sent events (text/event-stream) from options.url, over one
+        // long-lived GET. Events are decoded on the I/O thread as bytes
+        // arrive and handed to onEvent on the UI thread, in order. A dropped
+        // connection is reopened after the server's "retry:" time (doubled
+        // while attempts keep failing) with Last-Event-ID, so the server can
+        // replay what was missed. 204, a 4xx other than 408/429, or a cancel
+        // (Unsubscribe, CancelAll) closes the subscription for good.
+        // Subscriptions do not count against the per-host request limit.
+        size_t Subscribe(const SubscriptionOptions& options, EventCallback onEvent,
+            SubscriptionCallback onState = nullptr);
+        void Unsubscribe(size_t subscriptionId);
+        // Id of the last event delivered, to resume from in a later session
+        std::string GetLastEventId(size_t subscriptionId) const;
+
         void Cancel(size_t requestId);
         void CancelAll();
 
+        // Move a queued request to another class, e.g. when the user opens
+        // the page that needs it. False once it has started (or finished).
+        bool SetPriority(size_t requestId, RequestPriority priority);
+
         RequestState GetState(size_t requestId) const;
         Response GetResponse(size_t requestId) const;
 
         size_t GetActiveRequestCount() const;
         size_t GetPendingRequestCount() const;
         RequestStats GetStats() const;
+        // Sorted by host
+        std::vector<HostConcurrency> GetConcurrencyLimits() const;
 
-        void SetMaxConcurrentRequests(size_t max);
+        // In-flight requests per host: new hosts start at 'initial', the
+        // adaptive limit stays within [minimum, maximum]
+        void SetConcurrencyLimit(size_t initial, size_t minimum = 1, size_t maximum = 64);
+        // Off: every host keeps the initial limit, e.g. for benchmarks
+        void SetAdaptiveConcurrency(bool enabled);
+        // How long a queued request waits before it counts as one class more urgent
+        void SetPriorityAging(int milliseconds);
+        void SetMaxConnectionsPerHost(size_t max);
+        // In-flight HTTP/2 streams per host (and per connection)
+        void SetMaxConcurrentStreams(size_t max);
+        // After 'failureThreshold' consecutive failures a host's requests fail
+        // immediately for 'cooldownSeconds'; then one probe decides
+        void SetCircuitBreaker(size_t failureThreshold, int cooldownSeconds);
         void SetGlobalTimeout(int seconds);
         void SetUserAgent(const std::string& userAgent);
         void SetDefaultHeaders(const std::unordered_map<std::string, std::string>& headers);
 
         void ClearCache();
         void SetCacheMaxSize(size_t maxSizeMB);
-        bool IsCached(const std::string& url) const;
+        // Persistent cache cap; compaction to it happens at Init
+        void SetDiskCacheMaxSize(size_t maxSizeMB);
+        // In memory or on disk, under the key these options would use
+        // (URL plus Accept, Accept-Language and Authorization)
+        bool IsCached(const RequestOptions& options) const;
 
         std::string BuildQueryString(const std::unordered_map<std::string, std::string>& params);
         std::string UrlEncode(const std::string& value);
         std::string UrlDecode(const std::string& value);
 
         bool TestConnection(const std::string& url, int timeoutSeconds = 5);
-        std::vector<std::string> GetRequestHistory(size_t maxCount = 50) const;
+        // Most recent last
+        std::vector<RequestRecord> GetRequestHistory(size_t maxCount = 50) const;
+        void ClearRequestHistory();
+
+        // Sorted by request count, busiest first
+        std::vector<EndpointLatency> GetEndpointLatencies() const;
+        // Endpoint latencies, stats and history as one JSON document
+        std::string ExportMetricsJson() const;
 
     private:
-        BackgroundManager() = default;
+        BackgroundManager();
         ~BackgroundManager();
 
+        struct Subscription {
+            size_t id = 0;
+            SubscriptionOptions options;
+            EventCallback onEvent;
+            SubscriptionCallback onState;
+            std::atomic<bool> closed{ false };
+
+            // I/O thread, for the current connection
+            SseParser parser;
+            bool responseSeen = false;
+            bool accepted = false;          // 200 text/event-stream
+
+            // Guarded by m_Mutex
+            size_t requestId = 0;           // Current connection
+            bool connectPending = true;     // Waiting for reconnectAt
+            std::chrono::steady_clock::time_point reconnectAt;
+            int retryMs = 0;
+            int failedAttempts = 0;         // Since the last accepted response
+            std::string deliveredId;
+        };
+
+        // Download progress on its way to the UI thread. The I/O thread keeps
+        // the latest counts here and queues one dispatch at a time, which
+        // reads whatever is newest when Update() runs it.
+        struct ProgressRelay {
+            BackgroundManager* manager = nullptr;
+            ProgressCallback callback;
+            std::atomic<size_t> current{ 0 };
+            std::atomic<size_t> total{ 0 };
+            std::atomic<bool> queued{ false };
+        };
+
         struct RequestData {
             size_t id;
             RequestOptions options;
             RequestCallback callback;
-            ProgressCallback downloadProgressCallback;
+            std::shared_ptr<ProgressRelay> downloadProgress;
             UploadProgressCallback uploadProgressCallback;
+            ChunkCallback chunkCallback;
             std::shared_ptr<RequestHandle> handle;
-            std::thread thread;
-        };
+            RequestPriority priority = RequestPriority::Visible;    // Raised by followers and SetPriority
+            std::shared_ptr<Subscription> subscription;             // Set on event-stream connections
 
-        struct CachedResponse {
-            Response response;
-            std::chrono::steady_clock::time_point timestamp;
-            size_t accessCount = 0;
+            // Transfer state, owned by the I/O thread
+            std::string host;               // Pool key: scheme://host[:port]
+            void* easy = nullptr;           // CURL*
+            void* headerList = nullptr;     // curl_slist*
+            std::shared_ptr<BodyBuffer> body;   // Sized from Content-Length on the first write
+            size_t decodedBytes = 0;            // Delivered by curl after content decoding
+            std::vector<uint8_t> compressedBody;    // gzip of options.body when compressBody applies
+            std::unordered_map<std::string, std::string> responseHeaders;
+            std::chrono::steady_clock::time_point startTime;        // First attempt
+            std::chrono::steady_clock::time_point attemptStart;
+
+            // Tail-latency control (I/O thread)
+            std::chrono::steady_clock::time_point retryAt;
+            std::chrono::steady_clock::time_point hedgeAt;          // Unset when not armed
+            std::shared_ptr<RequestData> hedge;     // Duplicate transfer in flight
+            RequestData* hedgeOf = nullptr;         // Set on the duplicate itself
+            bool probe = false;                     // Half-open circuit trial
+            bool shortCircuited = false;
+            bool hedgeWon = false;
+
+            // Cache entry being revalidated, or the NetworkFirst fallback
+            std::string cacheKey;           // Empty when the cache is bypassed
+            Response cachedResponse;
+            bool hasCachedResponse = false;
+
+            // Identical requests sharing this transfer (guarded by m_Mutex)
+            std::string coalesceKey;        // Empty when not coalescable
+            std::vector<std::shared_ptr<RequestData>> followers;
+            bool detached = false;          // Own caller cancelled, still serving followers
         };
 
-        void ProcessRequest(std::shared_ptr<RequestData> request);
-        void ExecuteRequest(std::shared_ptr<RequestData> request);
-        void CompleteRequest(size_t requestId);
-        void UpdateStats(const Response& response, RequestState state);
+        size_t Submit(const std::shared_ptr<RequestData>& request);
+        static void CompressRequestBody(RequestData& request);
+
+        // I/O thread
+        void IOLoop();
+        void StartPendingTransfers();
+        bool StartTransfer(const std::shared_ptr<RequestData>& request);
+        void AbortCancelledTransfers();
+        void FinishTransfer(const std::shared_ptr<RequestData>& request, int curlResult);
+        bool RemoveActive(const std::shared_ptr<RequestData>& request);
+        void ReleaseTransfer(RequestData& request);
+        static size_t WriteBody(char* data, size_t size, size_t nmemb, void* userdata);
+        // CURLOPT_XFERINFOFUNCTION; int64_t is curl_off_t
+        static int TransferProgress(void* clientp, int64_t dltotal, int64_t dlnow,
+            int64_t ultotal, int64_t ulnow);
+        // The I/O thread builds results locally and publishes them to the
+        // handle under m_Mutex, where GetState()/GetResponse() read them
+        void DeliverResult(const std::shared_ptr<RequestData>& request, Response response, RequestState state);
+        void DeliverCancelled(const std::shared_ptr<RequestData>& request);
+        void PublishResult(RequestHandle& handle, RequestState state, const Response& response);
+
+        // Queue a callback for Update(); the main loop is woken once per
+        // I/O loop iteration that queued anything
+        void PostCallback(const RequestCallback& callback, RequestState state, const Response& response);
+        size_t DispatchCallbacks();
 
-        bool GetCachedResponse(const std::string& url, Response& response);
-        void CacheResponse(const std::string& url, const Response& response);
-        void CleanupCache();
+        // Retries, hedging and the circuit breaker (I/O thread)
+        bool ScheduleRetry(const std::shared_ptr<RequestData>& request, int curlResult, long statusCode);
+        void StartDueRetries();
+        void LaunchDueHedges();
+        void FinishHedge(const std::shared_ptr<RequestData>& hedge, int curlResult);
+        void CancelHedge(RequestData& request);
+        void ArmHedge(RequestData& request);
+        int NextTimerMs() const;
+        bool AllowHost(RequestData& request);
+        void RecordOutcome(const RequestData& request, bool failed);
+        static std::string EndpointKey(const RequestOptions& options);
 
-        std::vector<std::shared_ptr<RequestData>> m_ActiveRequests;
-        std::queue<std::shared_ptr<RequestData>> m_PendingRequests;
+        // Event-stream subscriptions: connects run on the I/O thread, the
+        // end of a connection is handled on the UI thread
+        void StartDueSubscriptions();
+        void ConnectSubscription(const std::shared_ptr<Subscription>& subscription);
+        void FeedSubscription(RequestData& request, std::string_view chunk);
+        void OnSubscriptionEnded(const std::shared_ptr<Subscription>& subscription,
+            RequestState state, const Response& response);
+        void PostSubscriptionState(const std::shared_ptr<Subscription>& subscription,
+            SubscriptionState state, const std::string& error);
+
+        // Adaptive concurrency (m_Mutex held)
+        ConcurrencyLimiter& HostLimiter(const std::string& host);
+        void RecordConcurrencySample(const RequestData& request, int curlResult, long statusCode);
+
+        // A cancelled transfer owner with live followers hands its caller a
+        // Cancelled result and keeps the transfer; false if nobody is left
+        bool DetachCancelledLeader(const std::shared_ptr<RequestData>& request);
+        static std::string CoalesceKey(const RequestOptions& options);
+
+        // At Submit, before the request is queued: answers it from the cache
+        // (returns true) or prepares the conditional headers and fallback for
+        // the network transfer
+        bool ApplyCachePolicy(const std::shared_ptr<RequestData>& request);
+        static std::string CacheKey(const RequestOptions& options);
+        void WakeIOThread();
+
+        // Easy handle pool (I/O thread only)
+        void* AcquireEasy(const std::string& host);
+        void ReleaseEasy(const std::string& host, void* easy);
+        void ClearEasyPool();
+        static std::string HostKey(const std::string& url);
+        static bool CanMultiplex(const RequestData& request);
+
+        // A request reached its final state. GetState/GetResponse keep
+        // answering for the most recent ones; older handles are dropped so
+        // their bodies return to the buffer pool.
+        void CompleteRequest(size_t requestId);
+        // 'timed': counts towards the average response time (not for
+        // event streams, which last as long as the subscription)
+        void UpdateStats(const Response& response, RequestState state, bool timed = true);
+        void RecordHistory(const RequestData& request, const Response& response, RequestState state);
+
+        std::vector<std::shared_ptr<RequestData>> m_ActiveRequests;    // On the multi handle
+        static constexpr size_t s_PriorityClasses = 4;
+        static constexpr size_t s_DispatchScanLimit = 32;  // Queued requests looked at per class and pop
+        RequestScheduler<std::shared_ptr<RequestData>, s_PriorityClasses> m_PendingRequests{
+            std::chrono::milliseconds(2000) };
         std::unordered_map<size_t, std::shared_ptr<RequestHandle>> m_Handles;
-        std::unordered_map<std::string, CachedResponse> m_Cache;
-        std::vector<std::string> m_RequestHistory;
+        std::deque<size_t> m_FinishedHandles;     // Oldest first
+        std::unordered_map<std::string, std::shared_ptr<RequestData>> m_InFlight;   // By CoalesceKey
+        std::unique_ptr<ResponseCache> m_ResponseCache;
+        std::unique_ptr<ResponseDiskCache> m_DiskCache;
+        // Fixed ring of the last s_HistorySize requests (guarded by m_Mutex)
+        std::vector<RequestRecord> m_History;
+        size_t m_HistoryNext = 0;
 
         mutable std::mutex m_Mutex;
         std::atomic<size_t> m_NextRequestId{ 1 };
-        std::atomic<size_t> m_MaxConcurrentRequests{ 4 };
         std::atomic<int> m_GlobalTimeout{ 30 };
         std::atomic<bool> m_Running{ false };
-        std::atomic<size_t> m_CacheMaxSize{ 100 };
+
+        struct Completion {
+            RequestCallback callback;
+            RequestState state;
+            Response response;
+        };
+
+        CompletionQueue<Completion> m_Completions;
+        std::atomic<bool> m_WakePending{ false };
+        std::atomic<bool> m_PostedSinceWake{ false };   // Cleared by the I/O thread
+
+        void* m_Multi = nullptr;            // CURLM*, kept opaque so the header does not pull in curl
+        void* m_Share = nullptr;            // CURLSH*
+        std::thread m_IOThread;
+
+        struct CircuitBreaker {
+            size_t failures = 0;                // Consecutive
+            std::chrono::steady_clock::time_point openUntil;
+            bool probing = false;
+        };
+
+        // Recent successful attempt latencies per endpoint, for hedging
+        struct LatencyWindow {
+            std::vector<double> samples;        // Ring of s_LatencyWindowSize
+            size_t next = 0;
+
+            void Add(double seconds);
+            double Percentile(double percentile) const;
+        };
+
+        std::vector<std::shared_ptr<RequestData>> m_Retrying;   // Active, waiting for retryAt
+        std::vector<std::shared_ptr<RequestData>> m_Hedges;     // On the multi handle, not active
+        std::unordered_map<std::string, CircuitBreaker> m_Breakers;     // By HostKey
+        std::unordered_map<std::string, LatencyWindow> m_Latency;       // By EndpointKey
+        std::mt19937 m_Random{ std::random_device{}() };
+        std::atomic<size_t> m_BreakerThreshold{ 5 };
+        std::atomic<int> m_BreakerCooldownSeconds{ 10 };
+
+        std::unordered_map<std::string, std::vector<void*>> m_EasyPool;
+        std::atomic<size_t> m_MaxConnectionsPerHost{ 6 };
+        size_t m_AppliedConnectionsPerHost = 0;     // I/O thread only
+
+        // Hosts whose last answer came over HTTP/2 (guarded by m_Mutex)
+        std::unordered_set<std::string> m_MultiplexedHosts;
+        std::atomic<size_t> m_MaxConcurrentStreams{ 100 };
+        size_t m_AppliedConcurrentStreams = 0;      // I/O thread only
+
+        // Per-host in-flight limits (guarded by m_Mutex)
+        std::unordered_map<std::string, ConcurrencyLimiter> m_HostLimits;
+        size_t m_InitialConcurrency = 4;
+        size_t m_MinConcurrency = 1;
+        size_t m_MaxConcurrency = 64;
+        bool m_AdaptiveConcurrency = true;
+        std::vector<std::shared_ptr<Subscription>> m_Subscriptions;    // Guarded by m_Mutex
+        std::atomic<size_t> m_NextSubscriptionId{ 1 };
+
+        // Every queued request's host was full at the last look; cleared
+        // when a request is queued, a slot frees up or a limit rises
+        bool m_QueueBlocked = false;
+
+        static constexpr size_t s_MaxPooledHandlesPerHost = 16;
+        static constexpr size_t s_MaxFinishedHandles = 64;
+        static constexpr size_t s_HistorySize = 128;
+        static constexpr size_t s_MinCompressedBodySize = 1024;
+        static constexpr int s_MaxRetryDelayMs = 30000;
+        static constexpr size_t s_LatencyWindowSize = 64;
+        static constexpr size_t s_MinHedgeSamples = 16;
+        static constexpr size_t s_MaxHedges = 4;
+        static constexpr int64_t s_MaxPresizeBytes = 64 * 1024 * 1024;     // Content-Length is only a hint
 
         std::string m_UserAgent;
         std::unordered_map<std::string, std::string> m_DefaultHeaders;
 
+        struct EndpointMetrics {
+            LatencyHistogram latency;
+            RequestTiming timingSum;
+        };
+
         RequestStats m_Stats;
+        size_t m_TimedResponses = 0;        // Successes in averageResponseTime
+        std::unordered_map<std::string, EndpointMetrics> m_Endpoints;     // By EndpointKey
         mutable std::mutex m_StatsMutex;
     };
 
@@ -0,0 +1,139 @@
+#include "body_buffer.h"
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <bit>
+#include <cstring>
+#include <algorithm>
+
+namespace Unicorn::Background {
+
+    // ============================================================================
+    // POOL
+    // ============================================================================
+
+    static constexpr size_t s_MinBufferSize = 4 * 1024;
+    static constexpr size_t s_MaxPooledBufferSize = 8 * 1024 * 1024;     // Larger ones are freed
+    static constexpr size_t s_MaxPooledBytes = 32 * 1024 * 1024;
+    static constexpr size_t s_MaxBuffersPerClass = 16;
+
+    // Four classes per power of two, so a Content-Length sized buffer wastes
+    // at most a quarter of its capacity
+    static size_t SizeClass(size_t size) {
+        if (size <= s_MinBufferSize) return s_MinBufferSize;
+
+        size_t step = std::bit_floor(size - 1) / 4;
+        return (size + step - 1) / step * step;
+    }
+
+    class BodyPool {
+    public:
+        char* Acquire(size_t capacity) {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                auto it = m_Free.find(capacity);
+                if (it != m_Free.end() && !it->second.empty()) {
+                    char* data = it->second.back();
+                    it->second.pop_back();
+                    m_Stats.pooledBuffers--;
+                    m_Stats.pooledBytes -= capacity;
+                    m_Stats.reused++;
+                    return data;
+                }
+                m_Stats.allocated++;
+            }
+            return new char[capacity];
+        }
+
+        void Release(char* data, size_t capacity) {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if (capacity <= s_MaxPooledBufferSize &&
+                    m_Stats.pooledBytes + capacity <= s_MaxPooledBytes) {
+                    auto& list = m_Free[capacity];
+                    if (list.size() < s_MaxBuffersPerClass) {
+                        list.push_back(data);
+                        m_Stats.pooledBuffers++;
+                        m_Stats.pooledBytes += capacity;
+                        return;
+                    }
+                }
+            }
+            delete[] data;
+        }
+
+        BodyPoolStats GetStats() {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            return m_Stats;
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::unordered_map<size_t, std::vector<char*>> m_Free;     // By capacity
+        BodyPoolStats m_Stats;
+    };
+
+    static BodyPool& GetPool() {
+        // Never destroyed: bodies held by other statics (caches, the
+        // manager) are released during exit after this would be gone
+        static BodyPool* pool = new BodyPool();
+        return *pool;
+    }
+
+    BodyPoolStats GetBodyPoolStats() {
+        return GetPool().GetStats();
+    }
+
+    // ============================================================================
+    // BODY BUFFER
+    // ============================================================================
+
+    BodyBuffer::BodyBuffer(size_t capacity) {
+        if (capacity > 0) {
+            Reserve(capacity);
+        }
+    }
+
+    BodyBuffer::~BodyBuffer() {
+        if (m_Data) {
+            GetPool().Release(m_Data, m_Capacity);
+        }
+    }
+
+    void BodyBuffer::Reserve(size_t capacity) {
+        if (capacity <= m_Capacity) return;
+
+        size_t newCapacity = SizeClass(capacity);
+        char* data = GetPool().Acquire(newCapacity);
+        if (m_Data) {
+            std::memcpy(data, m_Data, m_Size);
+            GetPool().Release(m_Data, m_Capacity);
+        }
+
+        m_Data = data;
+        m_Capacity = newCapacity;
+    }
+
+    void BodyBuffer::Append(const char* data, size_t size) {
+        if (size == 0) return;
+
+        if (m_Size + size > m_Capacity) {
+            // Unknown length: grow geometrically so appends stay amortized O(1)
+            Reserve(std::max(m_Size + size, m_Capacity * 2));
+        }
+
+        std::memcpy(m_Data + m_Size, data, size);
+        m_Size += size;
+    }
+
+    // ============================================================================
+    // BODY VIEW
+    // ============================================================================
+
+    BodyView BodyView::Copy(std::string_view data) {
+        auto buffer = std::make_shared<BodyBuffer>(data.size());
+        buffer->Append(data.data(), data.size());
+        return BodyView(std::move(buffer));
+    }
+
+} // namespace Unicorn::Background
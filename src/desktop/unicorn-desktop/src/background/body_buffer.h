@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstddef>
+
+namespace Unicorn::Background {
+
+    // Growable byte storage for a response body. Storage comes from a
+    // process-wide pool of size classes (at most 25% slack) and goes back to
+    // it when the buffer is destroyed, so steady traffic stops allocating.
+    // Written by one thread while the transfer runs, then frozen behind a
+    // BodyView.
+    class BodyBuffer {
+    public:
+        explicit BodyBuffer(size_t capacity = 0);
+        ~BodyBuffer();
+
+        BodyBuffer(const BodyBuffer&) = delete;
+        BodyBuffer& operator=(const BodyBuffer&) = delete;
+
+        void Reserve(size_t capacity);
+        void Append(const char* data, size_t size);
+
+        const char* Data() const { return m_Data; }
+        size_t Size() const { return m_Size; }
+        size_t Capacity() const { return m_Capacity; }
+
+    private:
+        char* m_Data = nullptr;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+    };
+
+    // Immutable, shared view of a response body. Copying a view (and so a
+    // Response) only bumps a reference count; the bytes are never copied.
+    class BodyView {
+    public:
+        BodyView() = default;
+        explicit BodyView(std::shared_ptr<const BodyBuffer> buffer)
+            : m_Buffer(std::move(buffer)) {}
+
+        // For bodies that do not come from a transfer (disk cache, tests)
+        static BodyView Copy(std::string_view data);
+
+        const char* Data() const { return m_Buffer ? m_Buffer->Data() : ""; }
+        size_t Size() const { return m_Buffer ? m_Buffer->Size() : 0; }
+        bool Empty() const { return Size() == 0; }
+
+        std::string_view View() const { return { Data(), Size() }; }
+        operator std::string_view() const { return View(); }
+
+        // Explicit copy for consumers that need to own or edit the text
+        std::string ToString() const { return std::string(View()); }
+
+    private:
+        std::shared_ptr<const BodyBuffer> m_Buffer;
+    };
+
+    struct BodyPoolStats {
+        size_t pooledBuffers = 0;
+        size_t pooledBytes = 0;
+        size_t reused = 0;          // Acquisitions served from the pool
+        size_t allocated = 0;       // Acquisitions that had to allocate
+    };
+
+    BodyPoolStats GetBodyPoolStats();
+
+} // namespace Unicorn::Background
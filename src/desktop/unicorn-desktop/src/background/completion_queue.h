@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+namespace Unicorn::Background {
+
+    // Lock-free multi-producer / single-consumer queue. Producers push onto an
+    // atomic singly linked stack with one CAS; the consumer detaches the whole
+    // stack with one exchange and reverses it, so a drain is a single batch in
+    // push order and never contends with producers for longer than that swap.
+    template<typename T>
+    class CompletionQueue {
+    public:
+        CompletionQueue() = default;
+        ~CompletionQueue() {
+            Drain([](T&) {});
+        }
+
+        CompletionQueue(const CompletionQueue&) = delete;
+        CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+        // Any thread
+        void Push(T value) {
+            Node* node = new Node{ std::move(value), m_Head.load(std::memory_order_relaxed) };
+            while (!m_Head.compare_exchange_weak(node->next, node,
+                std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        // Consumer thread only: hands every item pushed so far to 'fn', oldest
+        // first, and returns how many there were
+        template<typename Fn>
+        size_t Drain(Fn&& fn) {
+            Node* node = m_Head.exchange(nullptr, std::memory_order_acquire);
+
+            Node* ordered = nullptr;
+            while (node) {
+                Node* next = node->next;
+                node->next = ordered;
+                ordered = node;
+                node = next;
+            }
+
+            size_t count = 0;
+            while (ordered) {
+                Node* next = ordered->next;
+                fn(ordered->value);
+                delete ordered;
+                ordered = next;
+                count++;
+            }
+            return count;
+        }
+
+        bool Empty() const {
+            return m_Head.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct Node {
+            T value;
+            Node* next;
+        };
+
+        std::atomic<Node*> m_Head{ nullptr };
+    };
+
+} // namespace Unicorn::Background
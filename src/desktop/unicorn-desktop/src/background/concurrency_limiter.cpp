@@ -0,0 +1,124 @@
+#include "concurrency_limiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Unicorn::Background {
+
+    ConcurrencyLimiter::ConcurrencyLimiter(size_t initial, size_t minimum, size_t maximum) {
+        Configure(initial, minimum, maximum, true);
+    }
+
+    void ConcurrencyLimiter::Configure(size_t initial, size_t minimum, size_t maximum, bool adaptive) {
+        m_Minimum = std::max<size_t>(minimum, 1);
+        m_Maximum = std::max(maximum, m_Minimum);
+        m_Limit = static_cast<double>(std::clamp(initial, m_Minimum, m_Maximum));
+        m_Adaptive = adaptive;
+        m_SlowStart = true;
+        m_RecoverySamples = 0;
+        StartWindow();
+    }
+
+    void ConcurrencyLimiter::SetCeiling(size_t ceiling) {
+        m_Ceiling = std::max<size_t>(ceiling, 1);
+    }
+
+    size_t ConcurrencyLimiter::Limit() const {
+        size_t limit = std::max(static_cast<size_t>(m_Limit), m_Minimum);
+        return std::max<size_t>(std::min(limit, m_Ceiling), 1);
+    }
+
+    void ConcurrencyLimiter::Acquire() {
+        m_InFlight++;
+        m_WindowMaxInFlight = std::max(m_WindowMaxInFlight, m_InFlight);
+    }
+
+    void ConcurrencyLimiter::Release() {
+        if (m_InFlight > 0) m_InFlight--;
+    }
+
+    double ConcurrencyLimiter::BaselineLatency() const {
+        if (m_BaselinePrevious <= 0.0) return m_BaselineCurrent;
+        if (m_BaselineCurrent <= 0.0) return m_BaselinePrevious;
+        return std::min(m_BaselineCurrent, m_BaselinePrevious);
+    }
+
+    void ConcurrencyLimiter::StartWindow() {
+        m_WindowSamples = 0;
+        m_WindowLatencySum = 0.0;
+        m_WindowMaxInFlight = m_InFlight;
+    }
+
+    LimitDecision ConcurrencyLimiter::Decide(LimitDecision decision, double limit) {
+        double ceiling = static_cast<double>(std::min(m_Maximum, m_Ceiling));
+        m_Limit = std::clamp(limit, static_cast<double>(m_Minimum), std::max(ceiling, static_cast<double>(m_Minimum)));
+        m_LastDecision = decision;
+
+        switch (decision) {
+        case LimitDecision::Increase: m_Increases++; break;
+        case LimitDecision::DecreaseLatency: m_LatencyDecreases++; break;
+        case LimitDecision::DecreaseErrors: m_ErrorDecreases++; break;
+        case LimitDecision::Hold: break;
+        }
+        if (decision == LimitDecision::DecreaseLatency || decision == LimitDecision::DecreaseErrors) {
+            m_SlowStart = false;
+        }
+
+        StartWindow();
+        return decision;
+    }
+
+    LimitDecision ConcurrencyLimiter::OnSample(double seconds, bool overloaded, Clock::time_point now) {
+        bool recovering = m_RecoverySamples > 0;
+        if (recovering) m_RecoverySamples--;
+
+        if (overloaded) {
+            // Once per round: the rest of the requests that were in flight
+            // were sent under the old limit and would only repeat the news
+            if (!m_Adaptive || recovering) return LimitDecision::Hold;
+            m_RecoverySamples = m_InFlight;
+            return Decide(LimitDecision::DecreaseErrors, m_Limit * s_MaxDecrease);
+        }
+
+        m_WindowSamples++;
+        m_WindowLatencySum += seconds;
+        if (m_WindowSamples < std::max(s_MinWindowSamples, Limit())) {
+            return LimitDecision::Hold;
+        }
+
+        // Window means, not single samples: the baseline has to be comparable
+        // with a window's mix of fast and slow endpoints
+        double mean = m_WindowLatencySum / static_cast<double>(m_WindowSamples);
+        m_RecentLatency = mean;
+
+        if (now - m_BaselinePeriodStart >= s_BaselinePeriod) {
+            m_BaselinePrevious = m_BaselineCurrent;
+            m_BaselineCurrent = 0.0;
+            m_BaselinePeriodStart = now;
+        }
+        if (m_BaselineCurrent <= 0.0 || mean < m_BaselineCurrent) {
+            m_BaselineCurrent = mean;
+        }
+
+        if (!m_Adaptive) {
+            StartWindow();
+            return LimitDecision::Hold;
+        }
+
+        // Latency well above the baseline means requests are queueing
+        double allowed = BaselineLatency() * s_Tolerance;
+        if (mean > allowed) {
+            double gradient = std::max(allowed / mean, s_MaxDecrease);
+            return Decide(LimitDecision::DecreaseLatency, m_Limit * gradient);
+        }
+
+        // Only a window that hit the limit shows there is room for more
+        if (m_WindowMaxInFlight >= Limit() && Limit() < std::min(m_Maximum, m_Ceiling)) {
+            double grown = m_SlowStart ? m_Limit * 2.0 : m_Limit + std::max(1.0, std::sqrt(m_Limit));
+            return Decide(LimitDecision::Increase, grown);
+        }
+
+        StartWindow();
+        return LimitDecision::Hold;
+    }
+
+} // namespace Unicorn::Background
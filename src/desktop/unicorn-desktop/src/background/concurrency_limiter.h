@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace Unicorn::Background {
+
+    // What the limiter did at the end of a window (or on an overload signal)
+    enum class LimitDecision {
+        Hold,
+        Increase,
+        DecreaseLatency,
+        DecreaseErrors
+    };
+
+    // In-flight request limit for one host that follows what the server can
+    // take, in the spirit of TCP Vegas and gradient limiters. Completions are
+    // judged in windows of about one limit's worth of requests:
+    //
+    //   - an overload answer (429, 503 with Retry-After, timeout) halves the
+    //     limit at once; answers to requests already in flight at that
+    //     point cannot halve it again. Other failures are left to the
+    //     latency rule below
+    //   - a window whose mean latency exceeds s_Tolerance x the baseline (the
+    //     lowest window mean of the last one to two baseline periods) shrinks
+    //     it by that ratio, at most by half
+    //   - otherwise a window that used the whole limit grows it: doubling
+    //     until the first decrease (slow start), then by sqrt(limit)
+    //
+    // A window that never filled the limit says nothing about capacity and
+    // leaves it alone. Not thread-safe; the owner serialises access.
+    class ConcurrencyLimiter {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        ConcurrencyLimiter(size_t initial = 4, size_t minimum = 1, size_t maximum = 64);
+
+        // Starts over from 'initial'; not adaptive pins the limit there
+        void Configure(size_t initial, size_t minimum, size_t maximum, bool adaptive);
+        // What the transport allows (connections or HTTP/2 streams per host);
+        // the limit never grows past it
+        void SetCeiling(size_t ceiling);
+
+        bool CanAcquire() const { return m_InFlight < Limit(); }
+        void Acquire();
+        void Release();
+
+        // One finished attempt; 'overloaded' marks answers that say the
+        // server is saturated (their latency is not used)
+        LimitDecision OnSample(double seconds, bool overloaded, Clock::time_point now = Clock::now());
+
+        size_t Limit() const;
+        size_t InFlight() const { return m_InFlight; }
+        bool IsAdaptive() const { return m_Adaptive; }
+        bool InSlowStart() const { return m_SlowStart; }
+
+        double BaselineLatency() const;                             // Seconds; 0 before the first window
+        double RecentLatency() const { return m_RecentLatency; }    // Mean of the last window
+
+        size_t Increases() const { return m_Increases; }
+        size_t LatencyDecreases() const { return m_LatencyDecreases; }
+        size_t ErrorDecreases() const { return m_ErrorDecreases; }
+        LimitDecision LastDecision() const { return m_LastDecision; }
+
+    private:
+        void StartWindow();
+        LimitDecision Decide(LimitDecision decision, double limit);
+
+        double m_Limit = 1.0;
+        size_t m_Minimum = 1;
+        size_t m_Maximum = 1;
+        size_t m_Ceiling = static_cast<size_t>(-1);
+        bool m_Adaptive = true;
+        bool m_SlowStart = true;
+        size_t m_InFlight = 0;
+
+        // Current window
+        size_t m_WindowSamples = 0;
+        double m_WindowLatencySum = 0.0;
+        size_t m_WindowMaxInFlight = 0;
+        size_t m_RecoverySamples = 0;       // Still owed by requests sent before the last halving
+
+        // Windowed minimum of the window means, over two periods
+        double m_BaselineCurrent = 0.0;     // 0 = no window this period yet
+        double m_BaselinePrevious = 0.0;
+        Clock::time_point m_BaselinePeriodStart{};
+        double m_RecentLatency = 0.0;
+
+        size_t m_Increases = 0;
+        size_t m_LatencyDecreases = 0;
+        size_t m_ErrorDecreases = 0;
+        LimitDecision m_LastDecision = LimitDecision::Hold;
+
+        static constexpr size_t s_MinWindowSamples = 8;
+        static constexpr double s_Tolerance = 2.0;
+        static constexpr double s_MaxDecrease = 0.5;
+        static constexpr std::chrono::seconds s_BaselinePeriod{ 30 };
+    };
+
+} // namespace Unicorn::Background
@@ -0,0 +1,70 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Unicorn::Background {
+
+    size_t LatencyHistogram::BucketIndex(uint64_t micros) {
+        micros = std::min<uint64_t>(micros, (1ull << MaxValueBits) - 1);
+
+        // Below two octaves' worth of sub-buckets every microsecond has its
+        // own bucket; above, each octave keeps SubBucketCount buckets
+        if (micros < 2 * SubBucketCount) {
+            return static_cast<size_t>(micros);
+        }
+
+        int shift = std::bit_width(micros) - SubBucketBits - 1;
+        uint64_t subBucket = micros >> shift;       // In [SubBucketCount, 2 * SubBucketCount)
+        return static_cast<size_t>((shift + 1) * SubBucketCount + (subBucket - SubBucketCount));
+    }
+
+    uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+        if (index < 2 * SubBucketCount) {
+            return index;
+        }
+
+        int shift = static_cast<int>(index / SubBucketCount) - 1;
+        uint64_t subBucket = index % SubBucketCount + SubBucketCount;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::Record(double seconds) {
+        uint64_t micros = static_cast<uint64_t>(std::llround(std::max(seconds, 0.0) * 1e6));
+
+        m_Buckets[BucketIndex(micros)]++;
+        m_Count++;
+        m_MaxMicros = std::max(m_MaxMicros, micros);
+        m_SumSeconds += seconds;
+    }
+
+    void LatencyHistogram::Reset() {
+        m_Buckets.fill(0);
+        m_Count = 0;
+        m_MaxMicros = 0;
+        m_SumSeconds = 0.0;
+    }
+
+    double LatencyHistogram::Percentile(double percentile) const {
+        if (m_Count == 0) return 0.0;
+
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        uint64_t target = std::max<uint64_t>(1,
+            static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_Count))));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; i++) {
+            seen += m_Buckets[i];
+            if (seen >= target) {
+                return static_cast<double>(std::min(BucketUpperBound(i), m_MaxMicros)) / 1e6;
+            }
+        }
+
+        return Max();
+    }
+
+    double LatencyHistogram::Mean() const {
+        return m_Count > 0 ? m_SumSeconds / static_cast<double>(m_Count) : 0.0;
+    }
+
+} // namespace Unicorn::Background
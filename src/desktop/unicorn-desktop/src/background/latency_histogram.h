@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace Unicorn::Background {
+
+    // Fixed-size latency histogram in the style of HdrHistogram: values are
+    // bucketed by power of two, each octave split into 32 linear sub-buckets,
+    // so any percentile is within ~3% of the true value from 1 us up to about
+    // an hour, in constant memory and with O(1) recording.
+    class LatencyHistogram {
+    public:
+        void Record(double seconds);
+        void Reset();
+
+        // Upper bound of the bucket holding the given percentile (0-100),
+        // never above the largest value recorded
+        double Percentile(double percentile) const;
+
+        size_t Count() const { return m_Count; }
+        double Max() const { return static_cast<double>(m_MaxMicros) / 1e6; }
+        double Mean() const;
+
+    private:
+        static constexpr int SubBucketBits = 5;
+        static constexpr uint64_t SubBucketCount = 1ull << SubBucketBits;
+        static constexpr int MaxValueBits = 32;     // 2^32 us, ~71 minutes
+        static constexpr size_t BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+        static size_t BucketIndex(uint64_t micros);
+        static uint64_t BucketUpperBound(size_t index);
+
+        std::array<uint32_t, BucketCount> m_Buckets{};
+        size_t m_Count = 0;
+        uint64_t m_MaxMicros = 0;
+        double m_SumSeconds = 0.0;
+    };
+
+} // namespace Unicorn::Background
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Unicorn::Background {
+
+    // Pending-request queue with priority classes (0 = most urgent). Each
+    // class is a FIFO ordered by enqueue time; Pop compares only the class
+    // heads, so it is O(classes), and PopIf looks at no more than
+    // 'scanLimit' items per class. Waiting ages an item: every 'agingStep'
+    // spent in the queue counts as one class more urgent, so low classes
+    // cannot be starved by a steady stream of urgent work.
+    template<typename T, size_t ClassCount>
+    class RequestScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit RequestScheduler(std::chrono::milliseconds agingStep)
+            : m_AgingStep(agingStep) {}
+
+        void Push(T item, size_t priorityClass, Clock::time_point now = Clock::now()) {
+            Insert({ std::move(item), now }, std::min(priorityClass, ClassCount - 1));
+            m_Size++;
+        }
+
+        // Most urgent item whose aged class is at most 'maxClass'
+        bool Pop(T& out, size_t maxClass = ClassCount - 1, Clock::time_point now = Clock::now()) {
+            size_t best = Best(maxClass, now);
+            if (best == ClassCount) return false;
+
+            out = std::move(m_Classes[best].front().item);
+            m_Classes[best].pop_front();
+            m_Size--;
+            return true;
+        }
+
+        // Most urgent item 'accept(item, agedClass)' agrees to, e.g. one whose
+        // host still has room. Rejected items keep their place. Each class is
+        // walked up to its first accepted item but at most 'scanLimit' deep,
+        // so a long backlog behind a saturated consumer costs O(classes x
+        // scanLimit) per call rather than O(n); items past the window wait
+        // until the ones ahead of them leave.
+        template<typename Accept>
+        bool PopIf(T& out, Accept&& accept, size_t scanLimit, Clock::time_point now = Clock::now()) {
+            size_t best = ClassCount;
+            size_t bestIndex = 0;
+            double bestRank = 0.0;
+
+            for (size_t cls = 0; cls < ClassCount; cls++) {
+                const auto& queue = m_Classes[cls];
+                size_t scanned = std::min(queue.size(), scanLimit);
+                for (size_t i = 0; i < scanned; i++) {
+                    double rank = Rank(cls, queue[i].enqueued, now);
+                    if (!accept(queue[i].item, static_cast<size_t>(rank))) continue;
+
+                    // Ties go to the older entry
+                    if (best == ClassCount || rank < bestRank ||
+                        (rank == bestRank && queue[i].enqueued < m_Classes[best][bestIndex].enqueued)) {
+                        best = cls;
+                        bestIndex = i;
+                        bestRank = rank;
+                    }
+                    break;
+                }
+            }
+            if (best == ClassCount) return false;
+
+            auto& queue = m_Classes[best];
+            out = std::move(queue[bestIndex].item);
+            queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(bestIndex));
+            m_Size--;
+            return true;
+        }
+
+        // Moves the first item matching 'match' to another class, keeping
+        // the time it has already waited. False if nothing matched.
+        template<typename Match>
+        bool Reprioritize(Match&& match, size_t priorityClass) {
+            priorityClass = std::min(priorityClass, ClassCount - 1);
+
+            for (auto& queue : m_Classes) {
+                auto it = std::find_if(queue.begin(), queue.end(),
+                    [&](const Entry& entry) { return match(entry.item); });
+                if (it == queue.end()) continue;
+
+                Entry entry = std::move(*it);
+                queue.erase(it);
+                Insert(std::move(entry), priorityClass);
+                return true;
+            }
+            return false;
+        }
+
+        void Clear() {
+            for (auto& queue : m_Classes) {
+                queue.clear();
+            }
+            m_Size = 0;
+        }
+
+        void SetAgingStep(std::chrono::milliseconds step) { m_AgingStep = step; }
+
+        size_t Size() const { return m_Size; }
+        size_t Size(size_t priorityClass) const { return m_Classes[priorityClass].size(); }
+        bool Empty() const { return m_Size == 0; }
+
+    private:
+        struct Entry {
+            T item;
+            Clock::time_point enqueued;
+        };
+
+        void Insert(Entry entry, size_t priorityClass) {
+            auto& queue = m_Classes[priorityClass];
+            auto it = std::upper_bound(queue.begin(), queue.end(), entry.enqueued,
+                [](Clock::time_point time, const Entry& other) { return time < other.enqueued; });
+            queue.insert(it, std::move(entry));
+        }
+
+        size_t Best(size_t maxClass, Clock::time_point now) const {
+            size_t best = ClassCount;
+            double bestRank = 0.0;
+
+            for (size_t cls = 0; cls < ClassCount; cls++) {
+                if (m_Classes[cls].empty()) continue;
+
+                double rank = Rank(cls, m_Classes[cls].front().enqueued, now);
+                if (rank > static_cast<double>(maxClass)) continue;
+
+                // Ties go to the older entry
+                if (best == ClassCount || rank < bestRank ||
+                    (rank == bestRank && m_Classes[cls].front().enqueued < m_Classes[best].front().enqueued)) {
+                    best = cls;
+                    bestRank = rank;
+                }
+            }
+            return best;
+        }
+
+        double Rank(size_t priorityClass, Clock::time_point enqueued, Clock::time_point now) const {
+            if (m_AgingStep.count() <= 0) return static_cast<double>(priorityClass);
+
+            double waited = std::chrono::duration<double, std::milli>(now - enqueued).count();
+            double promoted = std::floor(waited / static_cast<double>(m_AgingStep.count()));
+            return std::max(0.0, static_cast<double>(priorityClass) - promoted);
+        }
+
+        std::array<std::deque<Entry>, ClassCount> m_Classes;
+        size_t m_Size = 0;
+        std::chrono::milliseconds m_AgingStep;
+    };
+
+} // namespace Unicorn::Background
@@ -0,0 +1,222 @@
+#include "response_cache.h"
+#include <algorithm>
+#include <cctype>
+
+namespace Unicorn::Background {
+
+    static bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+            [](unsigned char x, unsigned char y) { return std::tolower(x) == std::tolower(y); });
+    }
+
+    static int64_t ParseSeconds(std::string_view value) {
+        int64_t seconds = 0;
+        for (char c : value) {
+            if (c < '0' || c > '9') break;
+            seconds = seconds * 10 + (c - '0');
+        }
+        return seconds;
+    }
+
+    ResponseCache::~ResponseCache() {
+        Clear();
+    }
+
+    const std::string* ResponseCache::FindHeader(
+        const std::unordered_map<std::string, std::string>& headers, std::string_view name) {
+        for (const auto& [key, value] : headers) {
+            if (EqualsIgnoreCase(key, name)) return &value;
+        }
+        return nullptr;
+    }
+
+    // ============================================================================
+    // LOOKUP / STORE
+    // ============================================================================
+
+    bool ResponseCache::Lookup(const std::string& key, Response& outResponse, CacheValidators& outValidators) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_Entries.find(key);
+        if (it == m_Entries.end()) return false;
+
+        Entry* entry = it->second.get();
+        Unlink(entry);
+        Link(entry);
+
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - entry->storedAt).count();
+
+        outResponse = entry->response;
+        outValidators.etag = entry->etag;
+        outValidators.lastModified = entry->lastModified;
+        outValidators.fresh = !entry->noCache && age < entry->maxAgeSeconds;
+        return true;
+    }
+
+    void ResponseCache::Store(const std::string& key, const Response& response, int64_t ageSeconds) {
+        const std::string* cacheControl = FindHeader(response.headers, "Cache-Control");
+        if (cacheControl && cacheControl->find("no-store") != std::string::npos) {
+            Remove(key);
+            return;
+        }
+
+        auto entry = std::make_unique<Entry>();
+        entry->key = key;
+        entry->response = response;
+        entry->response.fromCache = false;
+        ApplyCachingHeaders(*entry, response.headers, ageSeconds);
+
+        entry->bytes = sizeof(Entry) + key.size() + response.body.Size();
+        for (const auto& [name, value] : response.headers) {
+            entry->bytes += name.size() + value.size();
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_Entries.find(key);
+        if (it != m_Entries.end()) {
+            RemoveEntry(it->second.get());
+        }
+        if (entry->bytes > m_MaxBytes) return;
+
+        Entry* raw = entry.get();
+        m_Entries.emplace(key, std::move(entry));
+        Link(raw);
+        m_Bytes += raw->bytes;
+
+        EvictToBudget();
+    }
+
+    bool ResponseCache::Refresh(const std::string& key, const Response& notModified) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_Entries.find(key);
+        if (it == m_Entries.end()) return false;
+
+        // Caching headers of a 304 replace the stored ones
+        Entry* entry = it->second.get();
+        for (const char* name : { "Cache-Control", "ETag", "Expires", "Last-Modified", "Date", "Age" }) {
+            if (const std::string* value = FindHeader(notModified.headers, name)) {
+                std::erase_if(entry->response.headers,
+                    [name](const auto& header) { return EqualsIgnoreCase(header.first, name); });
+                entry->response.headers[name] = *value;
+            }
+        }
+        ApplyCachingHeaders(*entry, entry->response.headers, 0);
+
+        Unlink(entry);
+        Link(entry);
+        return true;
+    }
+
+    void ResponseCache::ApplyCachingHeaders(Entry& entry,
+        const std::unordered_map<std::string, std::string>& headers, int64_t ageSeconds) {
+        entry.storedAt = std::chrono::steady_clock::now() - std::chrono::seconds(ageSeconds);
+        entry.maxAgeSeconds = 0;
+        entry.noCache = false;
+
+        if (const std::string* cacheControl = FindHeader(headers, "Cache-Control")) {
+            std::string directives = *cacheControl;
+            std::transform(directives.begin(), directives.end(), directives.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            size_t maxAge = directives.find("max-age=");
+            if (maxAge != std::string::npos) {
+                entry.maxAgeSeconds = ParseSeconds(std::string_view(directives).substr(maxAge + 8));
+            }
+            entry.noCache = directives.find("no-cache") != std::string::npos;
+        }
+
+        // Time already spent in upstream caches counts against max-age
+        if (const std::string* age = FindHeader(headers, "Age")) {
+            entry.maxAgeSeconds = std::max<int64_t>(0, entry.maxAgeSeconds - ParseSeconds(*age));
+        }
+
+        const std::string* etag = FindHeader(headers, "ETag");
+        entry.etag = etag ? *etag : std::string();
+
+        const std::string* lastModified = FindHeader(headers, "Last-Modified");
+        entry.lastModified = lastModified ? *lastModified : std::string();
+    }
+
+    // ============================================================================
+    // LRU LIST
+    // ============================================================================
+
+    void ResponseCache::Link(Entry* entry) {
+        entry->prev = nullptr;
+        entry->next = m_Head;
+        if (m_Head) m_Head->prev = entry;
+        m_Head = entry;
+        if (!m_Tail) m_Tail = entry;
+    }
+
+    void ResponseCache::Unlink(Entry* entry) {
+        if (entry->prev) entry->prev->next = entry->next;
+        else m_Head = entry->next;
+
+        if (entry->next) entry->next->prev = entry->prev;
+        else m_Tail = entry->prev;
+
+        entry->prev = entry->next = nullptr;
+    }
+
+    void ResponseCache::RemoveEntry(Entry* entry) {
+        Unlink(entry);
+        m_Bytes -= entry->bytes;
+
+        // The key must outlive the erase, which destroys the entry
+        std::string key = std::move(entry->key);
+        m_Entries.erase(key);
+    }
+
+    void ResponseCache::EvictToBudget() {
+        while (m_Bytes > m_MaxBytes && m_Tail) {
+            RemoveEntry(m_Tail);
+        }
+    }
+
+    bool ResponseCache::Contains(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Entries.find(key) != m_Entries.end();
+    }
+
+    void ResponseCache::Remove(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        auto it = m_Entries.find(key);
+        if (it != m_Entries.end()) {
+            RemoveEntry(it->second.get());
+        }
+    }
+
+    void ResponseCache::Clear() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Entries.clear();
+        m_Head = m_Tail = nullptr;
+        m_Bytes = 0;
+    }
+
+    void ResponseCache::SetMaxBytes(size_t maxBytes) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_MaxBytes = maxBytes;
+        EvictToBudget();
+    }
+
+    size_t ResponseCache::GetMaxBytes() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_MaxBytes;
+    }
+
+    size_t ResponseCache::GetBytes() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Bytes;
+    }
+
+    size_t ResponseCache::GetEntryCount() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Entries.size();
+    }
+
+} // namespace Unicorn::Background
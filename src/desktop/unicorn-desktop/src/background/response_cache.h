@@ -0,0 +1,87 @@
+#pragma once
+
+#include "background_manager.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+namespace Unicorn::Background {
+
+    // Freshness and validators of a cached response
+    struct CacheValidators {
+        std::string etag;
+        std::string lastModified;
+        bool fresh = false;     // Within max-age and not marked no-cache
+    };
+
+    // In-memory HTTP response cache with a byte budget. Entries are linked in
+    // recency order on an intrusive list, so lookup, touch and eviction are
+    // all O(1). Freshness follows Cache-Control (max-age, no-cache, no-store)
+    // minus the Age header; stale entries with an ETag or Last-Modified can
+    // be revalidated instead of downloaded again. Thread-safe.
+    class ResponseCache {
+    public:
+        ResponseCache() = default;
+        ~ResponseCache();
+
+        ResponseCache(const ResponseCache&) = delete;
+        ResponseCache& operator=(const ResponseCache&) = delete;
+
+        bool Lookup(const std::string& key, Response& outResponse, CacheValidators& outValidators);
+        // ageSeconds: how long ago the response was received (e.g. when it
+        // comes from the disk cache)
+        void Store(const std::string& key, const Response& response, int64_t ageSeconds = 0);
+
+        // A 304 for a cached entry: take the new caching headers and restart
+        // its freshness. Returns false if the entry was evicted meanwhile.
+        bool Refresh(const std::string& key, const Response& notModified);
+
+        bool Contains(const std::string& key) const;
+        void Remove(const std::string& key);
+        void Clear();
+
+        void SetMaxBytes(size_t maxBytes);
+        size_t GetMaxBytes() const;
+        size_t GetBytes() const;
+        size_t GetEntryCount() const;
+
+        // Case-insensitive header lookup, nullptr if absent
+        static const std::string* FindHeader(
+            const std::unordered_map<std::string, std::string>& headers, std::string_view name);
+
+    private:
+        struct Entry {
+            std::string key;
+            Response response;
+            std::string etag;
+            std::string lastModified;
+            std::chrono::steady_clock::time_point storedAt;
+            int64_t maxAgeSeconds = 0;
+            bool noCache = false;
+            size_t bytes = 0;
+
+            Entry* prev = nullptr;      // Towards most recently used
+            Entry* next = nullptr;
+        };
+
+        void ApplyCachingHeaders(Entry& entry, const std::unordered_map<std::string, std::string>& headers,
+            int64_t ageSeconds);
+        void Link(Entry* entry);
+        void Unlink(Entry* entry);
+        void RemoveEntry(Entry* entry);
+        void EvictToBudget();
+
+        std::unordered_map<std::string, std::unique_ptr<Entry>> m_Entries;
+        Entry* m_Head = nullptr;        // Most recently used
+        Entry* m_Tail = nullptr;        // Next to evict
+        size_t m_Bytes = 0;
+        size_t m_MaxBytes = 100 * 1024 * 1024;
+
+        mutable std::mutex m_Mutex;
+    };
+
+} // namespace Unicorn::Background
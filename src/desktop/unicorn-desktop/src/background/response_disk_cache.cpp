@@ -0,0 +1,283 @@
+#include "response_disk_cache.h"
+#include "response_cache.h"
+#include <filesystem>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Unicorn::Background {
+
+    static const char s_FileMagic[8] = { 'U', 'H', 'T', 'T', 'P', '\0', '\0', '\0' };
+
+    static int64_t UnixNow() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    ResponseDiskCache::~ResponseDiskCache() {
+        Close();
+    }
+
+    bool ResponseDiskCache::CreateEmpty(const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        FileHeader header = {};
+        std::memcpy(header.magic, s_FileMagic, sizeof(header.magic));
+        header.version = s_Version;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(file);
+    }
+
+    bool ResponseDiskCache::Open(const std::string& path) {
+        Close();
+
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+
+        if (!fs::exists(path, ec) || !MapAndIndex(path)) {
+            m_Mapping.Close();
+            m_Index.clear();
+            if (!CreateEmpty(path)) {
+                std::cerr << "[ResponseDiskCache] Failed to create " << path << std::endl;
+                return false;
+            }
+            MapAndIndex(path);
+        }
+
+        // Over the cap, or most of the file is superseded entries
+        size_t fileSize = m_Mapping.Size();
+        size_t deadBytes = fileSize - std::min(fileSize, m_LiveBytes + sizeof(FileHeader));
+        if (fileSize > m_MaxBytes || (deadBytes > m_LiveBytes && deadBytes > 1024 * 1024)) {
+            if (!Compact(path) || !MapAndIndex(path)) {
+                m_Mapping.Close();
+                m_Index.clear();
+                CreateEmpty(path);
+                MapAndIndex(path);
+            }
+        }
+
+        m_WrittenBytes = m_Mapping.Size();
+        m_Writer.open(path, std::ios::binary | std::ios::app);
+        if (!m_Writer) {
+            std::cerr << "[ResponseDiskCache] Failed to open " << path << " for writing" << std::endl;
+            m_Mapping.Close();
+            m_Index.clear();
+            return false;
+        }
+
+        m_Path = path;
+        std::cout << "[ResponseDiskCache] Mapped " << m_Index.size() << " responses from " << path << std::endl;
+        return true;
+    }
+
+    void ResponseDiskCache::Clear() {
+        std::unique_lock<std::shared_mutex> indexLock(m_IndexMutex);
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        if (!m_Writer.is_open()) return;
+
+        // The mapping has to go before the file can be truncated on Windows
+        m_Writer.close();
+        m_Mapping.Close();
+        m_Index.clear();
+        m_LiveBytes = 0;
+
+        if (!CreateEmpty(m_Path) || !MapAndIndex(m_Path)) {
+            std::cerr << "[ResponseDiskCache] Failed to clear " << m_Path << std::endl;
+            return;
+        }
+
+        m_WrittenBytes = m_Mapping.Size();
+        m_Writer.open(m_Path, std::ios::binary | std::ios::app);
+    }
+
+    void ResponseDiskCache::Close() {
+        std::unique_lock<std::shared_mutex> indexLock(m_IndexMutex);
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        if (m_Writer.is_open()) m_Writer.close();
+        m_Index.clear();
+        m_LiveBytes = 0;
+        m_Mapping.Close();
+    }
+
+    bool ResponseDiskCache::MapAndIndex(const std::string& path) {
+        m_Mapping.Close();
+        m_Index.clear();
+        m_LiveBytes = 0;
+
+        if (!m_Mapping.Open(path) || m_Mapping.Size() < sizeof(FileHeader)) {
+            return false;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, m_Mapping.Data(), sizeof(header));
+        if (std::memcmp(header.magic, s_FileMagic, sizeof(header.magic)) != 0 ||
+            header.version != s_Version) {
+            return false;
+        }
+
+        BuildIndex();
+        return true;
+    }
+
+    void ResponseDiskCache::BuildIndex() {
+        const uint8_t* data = m_Mapping.Data();
+        size_t size = m_Mapping.Size();
+        size_t offset = sizeof(FileHeader);
+
+        // Later entries replace earlier ones; a torn write at the end stops the scan
+        while (offset + sizeof(EntryHeader) <= size) {
+            Location location;
+            location.offset = offset;
+            std::memcpy(&location.header, data + offset, sizeof(EntryHeader));
+
+            const EntryHeader& entry = location.header;
+            size_t payload = size - offset - sizeof(EntryHeader);
+            if (entry.magic != s_EntryMagic ||
+                static_cast<uint64_t>(entry.keySize) + entry.headersSize + entry.bodySize > payload) {
+                break;
+            }
+
+            std::string key(reinterpret_cast<const char*>(data + offset + sizeof(EntryHeader)), entry.keySize);
+
+            auto [it, inserted] = m_Index.try_emplace(std::move(key), location);
+            if (!inserted) {
+                m_LiveBytes -= it->second.TotalSize();
+                it->second = location;
+            }
+            m_LiveBytes += location.TotalSize();
+
+            offset += location.TotalSize();
+        }
+    }
+
+    bool ResponseDiskCache::Compact(const std::string& path) {
+        // Newest entries first, until three quarters of the cap so the
+        // session has room to append
+        std::vector<const Location*> entries;
+        entries.reserve(m_Index.size());
+        for (const auto& [key, location] : m_Index) {
+            entries.push_back(&location);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Location* a, const Location* b) {
+            return a->header.storedAt > b->header.storedAt;
+        });
+
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) return false;
+
+            FileHeader header = {};
+            std::memcpy(header.magic, s_FileMagic, sizeof(header.magic));
+            header.version = s_Version;
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            size_t budget = m_MaxBytes / 4 * 3;
+            size_t written = sizeof(header);
+            for (const Location* location : entries) {
+                size_t entrySize = location->TotalSize();
+                if (written + entrySize > budget) continue;
+
+                file.write(reinterpret_cast<const char*>(m_Mapping.Data() + location->offset),
+                    static_cast<std::streamsize>(entrySize));
+                written += entrySize;
+            }
+
+            if (!file) return false;
+            std::cout << "[ResponseDiskCache] Compacted " << m_Mapping.Size() / 1024
+                << " KB to " << written / 1024 << " KB" << std::endl;
+        }
+
+        // The mapping has to go before the file can be replaced on Windows
+        m_Mapping.Close();
+        m_Index.clear();
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        return !ec;
+    }
+
+    // ============================================================================
+    // LOAD / STORE
+    // ============================================================================
+
+    bool ResponseDiskCache::Contains(const std::string& key) const {
+        std::shared_lock<std::shared_mutex> lock(m_IndexMutex);
+        return m_Index.find(key) != m_Index.end();
+    }
+
+    bool ResponseDiskCache::Load(const std::string& key, Response& outResponse, int64_t& outAgeSeconds) const {
+        std::shared_lock<std::shared_mutex> lock(m_IndexMutex);
+        auto it = m_Index.find(key);
+        if (it == m_Index.end()) return false;
+
+        const EntryHeader& entry = it->second.header;
+        const char* cursor = reinterpret_cast<const char*>(
+            m_Mapping.Data() + it->second.offset + sizeof(EntryHeader) + entry.keySize);
+
+        Response response;
+        response.statusCode = entry.statusCode;
+
+        std::string_view headers(cursor, entry.headersSize);
+        while (!headers.empty()) {
+            size_t lineEnd = headers.find("\r\n");
+            std::string_view line = headers.substr(0, lineEnd);
+            size_t colon = line.find(':');
+            if (colon != std::string_view::npos) {
+                std::string_view value = line.substr(colon + 1);
+                if (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+                response.headers[std::string(line.substr(0, colon))] = std::string(value);
+            }
+            if (lineEnd == std::string_view::npos) break;
+            headers.remove_prefix(lineEnd + 2);
+        }
+
+        response.body = BodyView::Copy(std::string_view(cursor + entry.headersSize, entry.bodySize));
+        response.downloadSize = entry.bodySize;
+
+        outResponse = std::move(response);
+        outAgeSeconds = std::max<int64_t>(0, UnixNow() - entry.storedAt);
+        return true;
+    }
+
+    void ResponseDiskCache::Store(const std::string& key, const Response& response) {
+        if (!IsOpen()) return;
+
+        const std::string* cacheControl = ResponseCache::FindHeader(response.headers, "Cache-Control");
+        if (cacheControl && cacheControl->find("no-store") != std::string::npos) return;
+
+        std::string headers;
+        for (const auto& [name, value] : response.headers) {
+            headers += name;
+            headers += ": ";
+            headers += value;
+            headers += "\r\n";
+        }
+
+        EntryHeader entry = {};
+        entry.magic = s_EntryMagic;
+        entry.keySize = static_cast<uint32_t>(key.size());
+        entry.headersSize = static_cast<uint32_t>(headers.size());
+        entry.bodySize = static_cast<uint32_t>(response.body.Size());
+        entry.storedAt = UnixNow();
+        entry.statusCode = response.statusCode;
+
+        size_t entrySize = sizeof(entry) + key.size() + headers.size() + response.body.Size();
+
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        if (!m_Writer.is_open() || m_WrittenBytes + entrySize > m_MaxBytes) {
+            return;     // Full until the next Open() compacts
+        }
+
+        m_Writer.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        m_Writer.write(key.data(), static_cast<std::streamsize>(key.size()));
+        m_Writer.write(headers.data(), static_cast<std::streamsize>(headers.size()));
+        m_Writer.write(response.body.Data(), static_cast<std::streamsize>(response.body.Size()));
+        m_Writer.flush();
+        m_WrittenBytes += entrySize;
+    }
+
+} // namespace Unicorn::Background
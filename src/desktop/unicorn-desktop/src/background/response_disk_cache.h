@@ -0,0 +1,93 @@
+#pragma once
+
+#include "background_manager.h"
+#include "../utils/mapped_file.h"
+#include <string>
+#include <unordered_map>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+
+namespace Unicorn::Background {
+
+    // Responses persisted across launches so the last known data can be shown
+    // before the network answers. The file is append-only: a newer entry for
+    // the same key supersedes the older one. It is memory-mapped and indexed
+    // at Open(); entries appended during a session are read on the next
+    // launch (the in-memory ResponseCache serves them until then). Open()
+    // compacts the file when it is over its size cap or mostly superseded
+    // entries, keeping the most recently stored responses.
+    class ResponseDiskCache {
+    public:
+        ResponseDiskCache() = default;
+        ~ResponseDiskCache();
+
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return m_Writer.is_open(); }
+
+        // All are safe to call from any thread. outAgeSeconds is the wall
+        // clock time since the response was stored.
+        bool Load(const std::string& key, Response& outResponse, int64_t& outAgeSeconds) const;
+        void Store(const std::string& key, const Response& response);
+        bool Contains(const std::string& key) const;
+
+        // Truncates the file to an empty cache; nothing stored before
+        // survives, in this session or the next
+        void Clear();
+
+        // Cap for the file; appends stop at the cap and Open() compacts below it
+        void SetMaxBytes(size_t maxBytes) { m_MaxBytes = maxBytes; }
+        size_t GetMaxBytes() const { return m_MaxBytes; }
+        size_t GetEntryCount() const {
+            std::shared_lock<std::shared_mutex> lock(m_IndexMutex);
+            return m_Index.size();
+        }
+
+    private:
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+        };
+
+        struct EntryHeader {
+            uint32_t magic;
+            uint32_t keySize;
+            uint32_t headersSize;   // "Name: value\r\n" lines
+            uint32_t bodySize;
+            int64_t storedAt;       // Unix seconds
+            int32_t statusCode;
+            uint32_t reserved;
+        };
+
+        struct Location {
+            size_t offset = 0;      // Of the EntryHeader in the mapping
+            EntryHeader header = {};
+
+            size_t TotalSize() const {
+                return sizeof(EntryHeader) + header.keySize + header.headersSize + header.bodySize;
+            }
+        };
+
+        bool CreateEmpty(const std::string& path);
+        bool MapAndIndex(const std::string& path);
+        bool Compact(const std::string& path);
+        void BuildIndex();
+
+        std::string m_Path;
+        MappedFile m_Mapping;
+        std::unordered_map<std::string, Location> m_Index;    // Changed only by Open() and Clear()
+        mutable std::shared_mutex m_IndexMutex;                 // Shared by Load(), exclusive for Clear()
+        size_t m_LiveBytes = 0;                                 // Entries still in the index
+        std::ofstream m_Writer;
+        size_t m_WrittenBytes = 0;
+        size_t m_MaxBytes = 64 * 1024 * 1024;
+        mutable std::mutex m_WriteMutex;
+
+        static constexpr uint32_t s_Version = 1;
+        static constexpr uint32_t s_EntryMagic = 0x50545448;   // "HTTP"
+    };
+
+} // namespace Unicorn::Background
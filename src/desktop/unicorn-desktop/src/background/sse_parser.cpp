@@ -0,0 +1,112 @@
+#include "sse_parser.h"
+#include <algorithm>
+
+namespace Unicorn::Background {
+
+    void SseParser::Feed(std::string_view chunk, const EventSink& onEvent) {
+        if (m_SkipLineFeed && !chunk.empty()) {
+            if (chunk.front() == '\n') chunk.remove_prefix(1);
+            m_SkipLineFeed = false;
+        }
+
+        while (!chunk.empty()) {
+            size_t end = chunk.find_first_of("\r\n");
+            if (end == std::string_view::npos) {
+                m_Line.append(chunk);
+                return;
+            }
+
+            if (m_Line.empty()) {
+                ProcessLine(chunk.substr(0, end), onEvent);
+            }
+            else {
+                m_Line.append(chunk.substr(0, end));
+                ProcessLine(m_Line, onEvent);
+                m_Line.clear();
+            }
+
+            // CRLF counts as one line ending, even across chunks
+            if (chunk[end] == '\r') {
+                if (end + 1 == chunk.size()) {
+                    m_SkipLineFeed = true;
+                }
+                else if (chunk[end + 1] == '\n') {
+                    end++;
+                }
+            }
+            chunk.remove_prefix(end + 1);
+        }
+    }
+
+    void SseParser::Reset() {
+        m_Line.clear();
+        m_SkipLineFeed = false;
+        m_StreamStart = true;
+        m_Data.clear();
+        m_Type.clear();
+    }
+
+    void SseParser::ProcessLine(std::string_view line, const EventSink& onEvent) {
+        if (m_StreamStart) {
+            m_StreamStart = false;
+            if (line.substr(0, 3) == "\xEF\xBB\xBF") line.remove_prefix(3);
+        }
+
+        if (line.empty()) {
+            Dispatch(onEvent);
+            return;
+        }
+        if (line.front() == ':') {
+            return;     // Comment, usually a keep-alive
+        }
+
+        std::string_view field = line;
+        std::string_view value;
+        size_t colon = line.find(':');
+        if (colon != std::string_view::npos) {
+            field = line.substr(0, colon);
+            value = line.substr(colon + 1);
+            if (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+        }
+
+        if (field == "data") {
+            m_Data.append(value);
+            m_Data += '\n';
+        }
+        else if (field == "event") {
+            m_Type.assign(value);
+        }
+        else if (field == "id") {
+            if (value.find('\0') == std::string_view::npos) {
+                m_LastEventId.assign(value);
+            }
+        }
+        else if (field == "retry") {
+            bool digits = !value.empty() && value.size() < 10 &&
+                std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; });
+            if (digits) {
+                m_RetryMs = std::stoi(std::string(value));
+            }
+        }
+        // Unknown fields are ignored
+    }
+
+    void SseParser::Dispatch(const EventSink& onEvent) {
+        // A blank line without data lines only resets the event type
+        if (m_Data.empty()) {
+            m_Type.clear();
+            return;
+        }
+
+        ServerEvent event;
+        m_Data.pop_back();      // The '\n' after the last data line
+        event.data = std::move(m_Data);
+        if (!m_Type.empty()) event.type = std::move(m_Type);
+        event.id = m_LastEventId;
+
+        m_Data.clear();
+        m_Type.clear();
+        onEvent(event);
+    }
+
+} // namespace Unicorn::Background
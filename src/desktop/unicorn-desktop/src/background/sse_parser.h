@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+
+namespace Unicorn::Background {
+
+    // One dispatched server-sent event
+    struct ServerEvent {
+        std::string type = "message";   // "event:" field
+        std::string data;               // "data:" lines joined with '\n'
+        std::string id;                 // Last "id:" seen, including earlier events'
+    };
+
+    // Incremental text/event-stream decoder (WHATWG HTML, "Server-sent
+    // events"). Feed it the body in whatever pieces the network delivers:
+    // lines may end in CRLF, LF or CR and may be split anywhere, including
+    // between the CR and LF. Only the unfinished line is buffered; complete
+    // lines are parsed straight out of the chunk.
+    class SseParser {
+    public:
+        using EventSink = std::function<void(ServerEvent& event)>;
+
+        void Feed(std::string_view chunk, const EventSink& onEvent);
+
+        // A new connection: the unfinished line and event are dropped, the
+        // last event id and retry time are kept for the reconnect
+        void Reset();
+
+        const std::string& LastEventId() const { return m_LastEventId; }
+        void SetLastEventId(std::string id) { m_LastEventId = std::move(id); }
+
+        // Reconnection time from the last "retry:" field; -1 if none yet
+        int RetryMs() const { return m_RetryMs; }
+
+    private:
+        void ProcessLine(std::string_view line, const EventSink& onEvent);
+        void Dispatch(const EventSink& onEvent);
+
+        std::string m_Line;             // Unfinished line carried over to the next chunk
+        bool m_SkipLineFeed = false;    // Last chunk ended in CR; a leading LF belongs to it
+        bool m_StreamStart = true;      // A UTF-8 BOM may precede the first line
+
+        std::string m_Data;
+        std::string m_Type;
+        std::string m_LastEventId;
+        int m_RetryMs = -1;
+    };
+
+} // namespace Unicorn::Background
@@ -5,8 +5,7 @@
 #include "../ui/ui_context.h"
 #include <GLFW/glfw3.h>
 #include <iostream>
-#include <chrono>
-#include <thread>
+#include <algorithm>
 
 namespace Unicorn {
 
@@ -21,10 +20,15 @@ namespace Unicorn {
         props.title = config.name;
         props.width = config.width;
         props.height = config.height;
+        props.vsync = config.vsync;
 
         m_Window = std::unique_ptr<Window>(Window::Create(props));
         m_Renderer = std::make_unique<Renderer>();
         m_UIContext = std::make_unique<UI::UIContext>();
+
+        m_FramePacer = std::make_unique<FramePacer>();
+        m_FramePacer->SetVSync(m_Window->IsVSync());
+        m_FramePacer->SetRefreshRate(m_Window->GetRefreshRate());
     }
 
     Application::~Application() {}
@@ -40,14 +44,29 @@ namespace Unicorn {
         m_UIContext->MarkDirty();
 
         while (m_Running && !m_Window->ShouldClose()) {
-            bool hasAnimations = m_UIContext->HasActiveAnimations();
-            bool isDirty = m_UIContext->IsDirty();
+            // Sleep until input arrives or the next animation deadline, whichever
+            // comes first. With nothing animating this blocks indefinitely.
+            // Continuous frames are additionally held back to the pacer's target
+            // (e.g. a source capped to 30 Hz on a 144 Hz display).
+            double deadline = m_UIContext->GetNextRedrawDeadline();
+            if (deadline != UI::AnimationController::NoDeadline) {
+                deadline = std::max(deadline, m_FramePacer->GetNextFrameTime());
+            }
 
-            if (!isDirty && !hasAnimations) {
+            if (m_UIContext->IsDirty()) {
+                glfwPollEvents();
+            }
+            else if (deadline == UI::AnimationController::NoDeadline) {
                 glfwWaitEvents();
             }
             else {
-                glfwPollEvents();
+                double timeout = deadline - UI::AnimationController::Now();
+                if (timeout > 0.0) {
+                    glfwWaitEventsTimeout(timeout);
+                }
+                else {
+                    glfwPollEvents();
+                }
             }
 
             double frameStart = glfwGetTime();
@@ -60,18 +79,22 @@ namespace Unicorn {
                 m_Renderer->OnWindowResize(width, height);
                 m_UIContext->OnWindowResize(width, height);
                 m_UIContext->MarkDirty();
-            }
 
-            if (hasAnimations) {
-                m_UIContext->UpdateAnimations(dt);
-
-                if (!m_UIContext->HasActiveAnimations()) {
-                    m_UIContext->MarkDirty();
-                }
+                // Resizes usually follow a move to another monitor
+                m_FramePacer->SetRefreshRate(m_Window->GetRefreshRate());
             }
 
+            m_UIContext->UpdateAnimations(UI::AnimationController::Now());
+            bool hasAnimations = m_UIContext->HasActiveAnimations();
+
             OnUpdate(dt);
 
+            // Workers only wake the loop; the redraw that uploads their icons
+            // is marked here, so ClearDirty after this frame cannot drop it
+            if (m_UIContext->HasPendingIconUploads()) {
+                m_UIContext->MarkDirty();
+            }
+
             if (m_UIContext->IsDirty() || hasAnimations) {
                 m_UIContext->BeginFrame();
                 OnUIRender();
@@ -84,18 +107,11 @@ namespace Unicorn {
 
                 m_Window->SwapBuffers();
                 m_UIContext->ClearDirty();
+
+                m_FramePacer->OnFramePresented(UI::AnimationController::Now(), hasAnimations);
             }
 
             Input::ResetMouseWheel();
-
-            if (hasAnimations) {
-                auto targetFrameTime = std::chrono::microseconds(16667);
-                auto frameTime = std::chrono::microseconds(static_cast<long long>(dt * 1000000.0));
-
-                if (frameTime < targetFrameTime) {
-                    std::this_thread::sleep_for(targetFrameTime - frameTime);
-                }
-            }
         }
 
         OnShutdown();
@@ -115,4 +131,8 @@ namespace Unicorn {
         glfwPostEmptyEvent();
     }
 
+    void Application::WakeMainLoop() {
+        glfwPostEmptyEvent();
+    }
+
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <memory>
 #include <string>
+#include "frame_pacer.h"
 
 namespace Unicorn {
     class Window;
@@ -24,10 +25,15 @@ namespace Unicorn {
 
         Window& GetWindow() { return *m_Window; }
         UI::UIContext& GetUI() { return *m_UIContext; }
+        FramePacer& GetFramePacer() { return *m_FramePacer; }
 
         static Application& Get() { return *s_Instance; }
         static void TriggerRender();
 
+        // Wake the main loop without touching UI state (safe from any thread);
+        // the woken frame decides whether anything needs to be drawn
+        static void WakeMainLoop();
+
     protected:
         virtual void OnInit() {}
         virtual void OnUpdate(float dt) {}
@@ -41,6 +47,7 @@ namespace Unicorn {
         std::unique_ptr<Window> m_Window;
         std::unique_ptr<Renderer> m_Renderer;
         std::unique_ptr<UI::UIContext> m_UIContext;
+        std::unique_ptr<FramePacer> m_FramePacer;
 
 
         bool m_Running = true;
@@ -0,0 +1,105 @@
+#include "frame_pacer.h"
+#include <algorithm>
+#include <limits>
+
+namespace Unicorn {
+
+    FramePacer::FramePacer() {
+        m_SourceCaps.fill(0.0);
+    }
+
+    void FramePacer::SetRefreshRate(int hz) {
+        if (hz <= 0) {
+            hz = 60; // Unknown mode: assume the common case
+        }
+
+        m_RefreshInterval = 1.0 / hz;
+        m_Stats.refreshRate = hz;
+    }
+
+    void FramePacer::SetSourceCap(FrameSource source, double hz) {
+        if (source == FrameSource::Count) return;
+        m_SourceCaps[static_cast<size_t>(source)] = std::max(0.0, hz);
+    }
+
+    double FramePacer::GetSourceCap(FrameSource source) const {
+        if (source == FrameSource::Count) return 0.0;
+        return m_SourceCaps[static_cast<size_t>(source)];
+    }
+
+    void FramePacer::Request(FrameSource source) {
+        if (source == FrameSource::Count) return;
+        m_RequestedSources |= 1u << static_cast<uint32_t>(source);
+    }
+
+    double FramePacer::GetTargetInterval() const {
+        if (m_PacedSources == 0) {
+            return m_RefreshInterval;
+        }
+
+        double interval = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < m_SourceCaps.size(); i++) {
+            if (m_PacedSources & (1u << i)) {
+                double cap = m_SourceCaps[i];
+                interval = std::min(interval, cap > 0.0 ? 1.0 / cap : m_RefreshInterval);
+            }
+        }
+
+        // Never pace faster than the display can show
+        return std::max(interval, m_RefreshInterval);
+    }
+
+    double FramePacer::GetNextFrameTime() const {
+        double target = GetTargetInterval();
+
+        if (m_Stats.vsync) {
+            if (target <= m_RefreshInterval * 1.05) {
+                return m_LastPresentTime;
+            }
+
+            // The swap snaps to the next vblank, so wake half a refresh early
+            // to land on the intended one rather than the one after it
+            return m_LastPresentTime + target - m_RefreshInterval * 0.5;
+        }
+
+        return m_LastPresentTime + target;
+    }
+
+    void FramePacer::OnFramePresented(double time, bool continuous) {
+        double target = GetTargetInterval();
+
+        if (continuous && m_LastWasContinuous && m_LastPresentTime > 0.0) {
+            double interval = time - m_LastPresentTime;
+
+            m_SmoothedInterval = (m_SmoothedInterval <= 0.0)
+                ? interval
+                : m_SmoothedInterval * 0.9 + interval * 0.1;
+
+            m_Stats.lastIntervalMs = interval * 1000.0;
+            m_Stats.worstIntervalMs = std::max(m_Stats.worstIntervalMs, m_Stats.lastIntervalMs);
+            m_Stats.measuredRate = m_SmoothedInterval > 0.0 ? 1.0 / m_SmoothedInterval : 0.0;
+
+            if (interval > target * 1.5) {
+                m_Stats.missedFrames += static_cast<uint64_t>(interval / target + 0.5) - 1;
+            }
+        }
+
+        m_LastPresentTime = time;
+        m_LastWasContinuous = continuous;
+        m_PacedSources = m_RequestedSources;
+        m_RequestedSources = 0;
+
+        m_Stats.framesPresented++;
+        m_Stats.targetRate = 1.0 / GetTargetInterval();
+    }
+
+    void FramePacer::ResetStats() {
+        FrameStats fresh;
+        fresh.refreshRate = m_Stats.refreshRate;
+        fresh.targetRate = m_Stats.targetRate;
+        fresh.vsync = m_Stats.vsync;
+        m_Stats = fresh;
+        m_SmoothedInterval = 0.0;
+    }
+
+} // namespace Unicorn
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <cstddef>
+
+namespace Unicorn {
+
+    // What is asking for continuous frames. Each source can be capped to its
+    // own rate; the fastest requesting source sets the pace.
+    enum class FrameSource {
+        Input = 0,      // Direct user interaction (always display rate)
+        Animation,      // Tweens (hover, press, transitions)
+        Scroll,         // Scroll physics / inertia
+        Count
+    };
+
+    struct FrameStats {
+        double refreshRate = 60.0;      // Display refresh rate (Hz)
+        double targetRate = 60.0;       // Current pacing target (Hz)
+        double measuredRate = 0.0;      // Smoothed rate of continuous presents (Hz)
+        double lastIntervalMs = 0.0;
+        double worstIntervalMs = 0.0;
+        uint64_t framesPresented = 0;
+        uint64_t missedFrames = 0;      // Deadlines skipped while animating
+        bool vsync = true;
+    };
+
+    class FramePacer {
+    public:
+        FramePacer();
+
+        // Refresh rate as reported by the monitor the window is on
+        void SetRefreshRate(int hz);
+        void SetVSync(bool enabled) { m_Stats.vsync = enabled; }
+        bool IsVSync() const { return m_Stats.vsync; }
+
+        // 0 = uncapped (display rate)
+        void SetSourceCap(FrameSource source, double hz);
+        double GetSourceCap(FrameSource source) const;
+
+        // Called during a frame by whatever needs the next one
+        void Request(FrameSource source);
+
+        // Called right after SwapBuffers. 'continuous' is true when this frame
+        // was rendered because something was animating (not one-off input).
+        void OnFramePresented(double time, bool continuous);
+
+        // Earliest time the next continuous frame should start. With vsync on
+        // and a target at display rate this is the last present time: the swap
+        // itself blocks, so waiting on top of it would only add latency.
+        double GetNextFrameTime() const;
+
+        const FrameStats& GetStats() const { return m_Stats; }
+        void ResetStats();
+
+    private:
+        double GetTargetInterval() const;
+
+        std::array<double, static_cast<size_t>(FrameSource::Count)> m_SourceCaps{};
+        uint32_t m_RequestedSources = 0;    // Bitmask for the frame being built
+        uint32_t m_PacedSources = 0;        // Bitmask of the last presented frame
+
+        double m_RefreshInterval = 1.0 / 60.0;
+        double m_LastPresentTime = 0.0;
+        double m_SmoothedInterval = 0.0;
+        bool m_LastWasContinuous = false;
+
+        FrameStats m_Stats;
+    };
+
+} // namespace Unicorn
\ No newline at end of file
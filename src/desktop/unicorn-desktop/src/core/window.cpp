@@ -39,7 +39,7 @@ namespace Unicorn {
             }
 
             glfwMakeContextCurrent(m_Window);
-            glfwSwapInterval(1);
+            SetVSync(props.vsync);
 
             m_Data.width = props.width;
             m_Data.height = props.height;
@@ -84,30 +84,12 @@ namespace Unicorn {
                 glfwPostEmptyEvent();
                 });
 
-            // ========================================
-            // CRITICAL: NO mouse move callback!
-            // Mouse position is read ONLY when rendering
-            // This prevents waking from glfwWaitEvents on every pixel movement
-            // ========================================
-
-            // Mouse move callback is DISABLED for maximum idle efficiency
-            // Position is read on-demand in Input::GetMousePosition()
-
-            // If you NEED hover effects, enable this with throttling:
-            /*
+            // 5. Mouse move - hover state is only evaluated while rendering, so
+            // movement must wake the loop. Idle cost stays at zero: without
+            // movement (and without running animations) glfwWaitEvents blocks.
             glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xpos, double ypos) {
-                static auto lastUpdate = std::chrono::high_resolution_clock::now();
-                auto now = std::chrono::high_resolution_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate);
-
-                // Throttle to 30 FPS max (33ms between updates)
-                if (elapsed.count() < 33) return;
-
-                lastUpdate = now;
                 Application::Get().GetUI().MarkDirty();
-                glfwPostEmptyEvent();
-            });
-            */
+                });
 
             glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
                 Application::Get().GetUI().MarkDirty();
@@ -156,6 +138,51 @@ namespace Unicorn {
             glfwSetCursor(m_Window, cursor);
         }
 
+        void SetVSync(bool enabled) override {
+            glfwSwapInterval(enabled ? 1 : 0);
+            m_VSync = enabled;
+        }
+
+        bool IsVSync() const override {
+            return m_VSync;
+        }
+
+        int GetRefreshRate() const override {
+            // Windowed mode has no owning monitor; pick the one under the window center
+            int winX = 0, winY = 0, winW = 0, winH = 0;
+            glfwGetWindowPos(m_Window, &winX, &winY);
+            glfwGetWindowSize(m_Window, &winW, &winH);
+            int centerX = winX + winW / 2;
+            int centerY = winY + winH / 2;
+
+            GLFWmonitor* target = glfwGetWindowMonitor(m_Window);
+
+            if (!target) {
+                int count = 0;
+                GLFWmonitor** monitors = glfwGetMonitors(&count);
+                for (int i = 0; i < count; i++) {
+                    const GLFWvidmode* mode = glfwGetVideoMode(monitors[i]);
+                    if (!mode) continue;
+
+                    int monX = 0, monY = 0;
+                    glfwGetMonitorPos(monitors[i], &monX, &monY);
+
+                    if (centerX >= monX && centerX < monX + mode->width &&
+                        centerY >= monY && centerY < monY + mode->height) {
+                        target = monitors[i];
+                        break;
+                    }
+                }
+            }
+
+            if (!target) {
+                target = glfwGetPrimaryMonitor();
+            }
+
+            const GLFWvidmode* mode = target ? glfwGetVideoMode(target) : nullptr;
+            return mode ? mode->refreshRate : 60;
+        }
+
         void OnUpdate() override {}
 
         void SwapBuffers() override {
@@ -197,6 +224,7 @@ namespace Unicorn {
         GLFWcursor* m_HandCursor = nullptr;
         GLFWcursor* m_ArrowCursor = nullptr;
         GLFWcursor* m_IBeamCursor = nullptr;
+        bool m_VSync = true;
 
         struct WindowData {
             uint32_t width, height;
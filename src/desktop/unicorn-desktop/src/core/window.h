@@ -11,6 +11,7 @@ namespace Unicorn {
         std::string title = "Unicorn";
         uint32_t width = 1280;
         uint32_t height = 720;
+        bool vsync = true;
     };
 
     class Window {
@@ -27,6 +28,11 @@ namespace Unicorn {
         virtual bool IsResizing() const = 0;
         virtual void* GetNativeWindow() const = 0;
         virtual void SetCursor(int cursorType) = 0;
+        virtual void SetVSync(bool enabled) = 0;
+        virtual bool IsVSync() const = 0;
+
+        // Refresh rate (Hz) of the monitor the window currently sits on
+        virtual int GetRefreshRate() const = 0;
 
         static Window* Create(const WindowProps& props);
     };
@@ -103,6 +103,55 @@ namespace Unicorn::Crypto {
         return Compress(data, level);
     }
 
+    CompressionResult CryptoManager::CompressGzip(
+        const uint8_t* data,
+        size_t size,
+        CompressionLevel level
+    ) {
+        CompressionResult result;
+        result.originalSize = size;
+
+#ifdef HAVE_ZLIB
+        if (!data || size == 0) {
+            result.error = "Input data is empty";
+            return result;
+        }
+
+        z_stream stream = {};
+        // windowBits 15 + 16 selects the gzip header and trailer
+        int zlibResult = deflateInit2(&stream, static_cast<int>(level), Z_DEFLATED,
+            15 + 16, 8, Z_DEFAULT_STRATEGY);
+        if (zlibResult != Z_OK) {
+            result.error = "Compression failed with code " + std::to_string(zlibResult);
+            return result;
+        }
+
+        result.data.resize(deflateBound(&stream, static_cast<uLong>(size)));
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = static_cast<uInt>(size);
+        stream.next_out = result.data.data();
+        stream.avail_out = static_cast<uInt>(result.data.size());
+
+        zlibResult = deflate(&stream, Z_FINISH);
+        deflateEnd(&stream);
+
+        if (zlibResult == Z_STREAM_END) {
+            result.data.resize(stream.total_out);
+            result.compressedSize = stream.total_out;
+            result.compressionRatio = (float)result.originalSize / (float)result.compressedSize;
+            result.success = true;
+        }
+        else {
+            result.data.clear();
+            result.error = "Compression failed with code " + std::to_string(zlibResult);
+        }
+#else
+        result.error = "ZLIB not available";
+#endif
+
+        return result;
+    }
+
     CompressionResult CryptoManager::Decompress(const std::vector<uint8_t>& compressedData) {
         CompressionResult result;
 
@@ -148,6 +197,43 @@ namespace Unicorn::Crypto {
         return result;
     }
 
+    CompressionResult CryptoManager::Decompress(const uint8_t* compressedData, size_t compressedSize,
+        size_t originalSize) {
+        CompressionResult result;
+
+#ifdef HAVE_ZLIB
+        if (!compressedData || compressedSize == 0) {
+            result.error = "Compressed data is empty";
+            return result;
+        }
+
+        result.data.resize(originalSize);
+        uLongf decompressedSize = static_cast<uLongf>(originalSize);
+
+        int zlibResult = uncompress(
+            result.data.data(),
+            &decompressedSize,
+            compressedData,
+            static_cast<uLong>(compressedSize)
+        );
+
+        if (zlibResult == Z_OK && decompressedSize == originalSize) {
+            result.originalSize = decompressedSize;
+            result.compressedSize = compressedSize;
+            result.compressionRatio = (float)result.originalSize / (float)result.compressedSize;
+            result.success = true;
+        }
+        else {
+            result.data.clear();
+            result.error = "Decompression failed with code " + std::to_string(zlibResult);
+        }
+#else
+        result.error = "ZLIB not available";
+#endif
+
+        return result;
+    }
+
     std::string CryptoManager::DecompressToString(const std::vector<uint8_t>& compressedData) {
         auto result = Decompress(compressedData);
         if (result.success) {
@@ -59,9 +59,22 @@ namespace Unicorn::Crypto {
             CompressionLevel level = CompressionLevel::Balanced
         );
 
+        // Compress with a gzip wrapper (RFC 1952), e.g. for an HTTP body sent
+        // with Content-Encoding: gzip
+        CompressionResult CompressGzip(
+            const uint8_t* data,
+            size_t size,
+            CompressionLevel level = CompressionLevel::BestSpeed
+        );
+
         // Decompress data
         CompressionResult Decompress(const std::vector<uint8_t>& compressedData);
 
+        // Decompress when the original size is known (e.g. stored alongside
+        // the data); decodes in one pass straight from a borrowed buffer
+        CompressionResult Decompress(const uint8_t* compressedData, size_t compressedSize,
+            size_t originalSize);
+
         // Decompress to string
         std::string DecompressToString(const std::vector<uint8_t>& compressedData);
 
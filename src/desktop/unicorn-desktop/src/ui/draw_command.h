@@ -36,6 +36,8 @@ namespace Unicorn::UI {
         std::string text;
         int textDirection = 0; // 0 = Auto, 1 = LTR, 2 = RTL
         uint32_t textureID = 0;
+        glm::vec2 uvMin = glm::vec2(0.0f);    // Icon rect within textureID
+        glm::vec2 uvMax = glm::vec2(1.0f);
 
         // Border properties
         BorderStyle borderStyle = BorderStyle::None;
@@ -316,7 +316,12 @@ namespace Unicorn::UI {
             return false;
         }
 
-        return LoadCharacterRange(it->second.face, start, end);
+        if (!LoadCharacterRange(it->second.face, start, end)) {
+            return false;
+        }
+
+        m_Generation++;
+        return true;
     }
 
     bool FontManager::SetActiveFont(const std::string& name) {
@@ -331,6 +336,7 @@ namespace Unicorn::UI {
         m_ActiveKerningCache = it->second.kerningCache;
         m_ActiveFace = it->second.face;
         m_RenderOptions = it->second.renderOptions;
+        m_Generation++;
 
         std::cout << "[FontManager] Active font: " << name << " | "
             << m_ActiveCharacters.size() << " characters" << std::endl;
@@ -417,6 +423,7 @@ namespace Unicorn::UI {
 
     void FontManager::SetRenderOptions(const FontRenderOptions& options) {
         m_RenderOptions = options;
+        m_Generation++;
     }
 
     uint32_t FontManager::UTF8ToCodepoint(const char*& str) {
@@ -496,8 +503,10 @@ namespace Unicorn::UI {
         }
 
         std::vector<uint32_t> codepoints;
+        std::vector<uint32_t> clusters;
         const char* str = utf8Text.c_str();
         while (*str) {
+            clusters.push_back(static_cast<uint32_t>(str - utf8Text.c_str()));
             codepoints.push_back(UTF8ToCodepoint(str));
         }
 
@@ -505,6 +514,7 @@ namespace Unicorn::UI {
 
         struct TextRun {
             std::vector<uint32_t> codepoints;
+            std::vector<uint32_t> clusters;
             bool isRTL;
         };
 
@@ -512,6 +522,7 @@ namespace Unicorn::UI {
         TextRun currentRun;
         currentRun.isRTL = IsRTLCodepoint(codepoints[0]);
         currentRun.codepoints.push_back(codepoints[0]);
+        currentRun.clusters.push_back(clusters[0]);
 
         for (size_t i = 1; i < codepoints.size(); i++) {
             uint32_t cp = codepoints[i];
@@ -520,15 +531,18 @@ namespace Unicorn::UI {
 
             if (isSpace) {
                 currentRun.codepoints.push_back(cp);
+                currentRun.clusters.push_back(clusters[i]);
             }
             else if (cpIsRTL != currentRun.isRTL) {
                 runs.push_back(currentRun);
                 currentRun = TextRun();
                 currentRun.isRTL = cpIsRTL;
                 currentRun.codepoints.push_back(cp);
+                currentRun.clusters.push_back(clusters[i]);
             }
             else {
                 currentRun.codepoints.push_back(cp);
+                currentRun.clusters.push_back(clusters[i]);
             }
         }
 
@@ -548,15 +562,19 @@ namespace Unicorn::UI {
         for (auto& run : runs) {
             if (run.isRTL) {
                 std::reverse(run.codepoints.begin(), run.codepoints.end());
+                std::reverse(run.clusters.begin(), run.clusters.end());
             }
 
-            for (uint32_t cp : run.codepoints) {
+            for (size_t i = 0; i < run.codepoints.size(); i++) {
+                uint32_t cp = run.codepoints[i];
                 const Character& ch = GetCharacter(cp);
                 ShapedGlyph glyph;
                 glyph.glyphIndex = cp;
                 glyph.codepoint = cp;
                 glyph.offset = glm::vec2(xPos, 0.0f);
                 glyph.advance = glm::vec2((ch.advance >> 6), 0.0f);
+                glyph.cluster = run.clusters[i];
+                glyph.rtl = run.isRTL;
                 allGlyphs.push_back(glyph);
                 xPos += glyph.advance.x;
             }
@@ -89,6 +89,10 @@ namespace Unicorn::UI {
         FT_Face GetActiveFace() const { return m_ActiveFace; }
         const std::string& GetActiveFontName() const { return m_ActiveFontName; }
 
+        // Bumped whenever text metrics may have changed (active font, render
+        // options, newly loaded ranges) so cached measurements can be dropped
+        uint32_t GetGeneration() const { return m_Generation; }
+
     private:
         bool LoadCharacters(FT_Face face, uint32_t fontSize);
         bool LoadCharacterRange(FT_Face face, uint32_t start, uint32_t end);
@@ -118,6 +122,7 @@ namespace Unicorn::UI {
         std::string m_ActiveFontName;
         FT_Face m_ActiveFace = nullptr;
         Character m_DefaultCharacter;
+        uint32_t m_Generation = 0;
 
         std::unique_ptr<TextShaper> m_TextShaper;
         FontRenderOptions m_RenderOptions;
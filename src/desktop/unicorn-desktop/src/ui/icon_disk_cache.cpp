@@ -0,0 +1,160 @@
+#include "icon_disk_cache.h"
+#include "icon_sdf.h"
+#ifdef HAVE_ZLIB
+#include "../crypto/crypto_manager.h"
+#endif
+#include <filesystem>
+#include <iostream>
+#include <cstring>
+
+namespace Unicorn::UI {
+
+    static const char s_FileMagic[8] = { 'U', 'I', 'C', 'O', 'N', 'S', '\0', '\0' };
+
+    IconDiskCache::~IconDiskCache() {
+        Close();
+    }
+
+    uint64_t IconDiskCache::HashSVG(std::string_view svg) {
+        // FNV-1a, 64-bit
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : svg) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool IconDiskCache::CreateEmpty(const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        FileHeader header = {};
+        std::memcpy(header.magic, s_FileMagic, sizeof(header.magic));
+        header.version = s_Version;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(file);
+    }
+
+    bool IconDiskCache::Open(const std::string& path) {
+        Close();
+
+#ifndef HAVE_ZLIB
+        std::cout << "[IconDiskCache] Disabled (ZLIB not available)" << std::endl;
+        return false;
+#else
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+
+        // Start over when the file is missing, from another version, or has
+        // accumulated too many entries for SVGs that have since changed
+        bool recreate = !fs::exists(path, ec) || fs::file_size(path, ec) > s_MaxFileSize;
+        if (!recreate && m_Mapping.Open(path)) {
+            FileHeader header;
+            recreate = m_Mapping.Size() < sizeof(header);
+            if (!recreate) {
+                std::memcpy(&header, m_Mapping.Data(), sizeof(header));
+                recreate = std::memcmp(header.magic, s_FileMagic, sizeof(header.magic)) != 0 ||
+                    header.version != s_Version;
+            }
+        }
+
+        if (recreate) {
+            m_Mapping.Close();
+            if (!CreateEmpty(path)) {
+                std::cerr << "[IconDiskCache] Failed to create " << path << std::endl;
+                return false;
+            }
+        }
+        else {
+            BuildIndex();
+        }
+
+        m_Writer.open(path, std::ios::binary | std::ios::app);
+        if (!m_Writer) {
+            std::cerr << "[IconDiskCache] Failed to open " << path << " for writing" << std::endl;
+            m_Mapping.Close();
+            m_Index.clear();
+            return false;
+        }
+
+        std::cout << "[IconDiskCache] Mapped " << m_Index.size() << " icons from " << path << std::endl;
+        return true;
+#endif
+    }
+
+    void IconDiskCache::Close() {
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        if (m_Writer.is_open()) m_Writer.close();
+        m_Index.clear();
+        m_Mapping.Close();
+    }
+
+    void IconDiskCache::BuildIndex() {
+        const uint8_t* data = m_Mapping.Data();
+        size_t size = m_Mapping.Size();
+        size_t offset = sizeof(FileHeader);
+
+        // Walk entry headers only; a torn write at the end stops the scan
+        while (offset + sizeof(EntryHeader) <= size) {
+            EntryHeader entry;
+            std::memcpy(&entry, data + offset, sizeof(entry));
+
+            size_t payload = offset + sizeof(EntryHeader);
+            if (entry.magic != s_EntryMagic || entry.compressedSize > size - payload) {
+                break;
+            }
+
+            Location location;
+            location.offset = payload;
+            location.rawSize = entry.rawSize;
+            location.compressedSize = entry.compressedSize;
+            m_Index[entry.svgHash] = location;
+
+            offset = payload + entry.compressedSize;
+        }
+    }
+
+    bool IconDiskCache::Load(uint64_t svgHash, std::vector<unsigned char>& outField) const {
+#ifdef HAVE_ZLIB
+        auto it = m_Index.find(svgHash);
+        if (it == m_Index.end()) return false;
+
+        size_t pixelSize = static_cast<size_t>(IconSDFLayout::Size);
+        if (it->second.rawSize != pixelSize * pixelSize) return false;
+
+        auto result = Crypto::CryptoManager::Get().Decompress(
+            m_Mapping.Data() + it->second.offset, it->second.compressedSize, it->second.rawSize);
+        if (!result.success) return false;
+
+        outField = std::move(result.data);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void IconDiskCache::Store(uint64_t svgHash, const std::vector<unsigned char>& field) {
+#ifdef HAVE_ZLIB
+        if (!IsOpen() || field.empty()) return;
+
+        auto result = Crypto::CryptoManager::Get().Compress(field, Crypto::CompressionLevel::BestSpeed);
+        if (!result.success) return;
+
+        EntryHeader entry = {};
+        entry.magic = s_EntryMagic;
+        entry.pixelSize = static_cast<uint32_t>(IconSDFLayout::Size);
+        entry.svgHash = svgHash;
+        entry.rawSize = static_cast<uint32_t>(field.size());
+        entry.compressedSize = static_cast<uint32_t>(result.data.size());
+
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        m_Writer.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        m_Writer.write(reinterpret_cast<const char*>(result.data.data()),
+            static_cast<std::streamsize>(result.data.size()));
+        m_Writer.flush();
+#endif
+    }
+
+} // namespace Unicorn::UI
@@ -0,0 +1,71 @@
+#pragma once
+#include "../utils/mapped_file.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <cstdint>
+
+namespace Unicorn::UI {
+
+    // Icon distance fields persisted across launches. Entries are keyed by the
+    // SVG content hash (every field has the same IconSDFLayout::Size), so
+    // editing an SVG simply misses
+    // and the stale entry is never read again. The file is memory-mapped and
+    // indexed at Open(); new entries are appended (zlib, BestSpeed) and show
+    // up in the index on the next launch. Once the file grows past
+    // s_MaxFileSize it is discarded at Open() and rebuilt from what is drawn.
+    class IconDiskCache {
+    public:
+        IconDiskCache() = default;
+        ~IconDiskCache();
+
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return m_Writer.is_open(); }
+
+        // Both are safe to call from worker threads
+        bool Load(uint64_t svgHash, std::vector<unsigned char>& outField) const;
+        void Store(uint64_t svgHash, const std::vector<unsigned char>& field);
+
+        static uint64_t HashSVG(std::string_view svg);
+
+        size_t GetEntryCount() const { return m_Index.size(); }
+
+    private:
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+        };
+
+        struct EntryHeader {
+            uint32_t magic;
+            uint32_t pixelSize;
+            uint64_t svgHash;
+            uint32_t rawSize;
+            uint32_t compressedSize;
+        };
+
+        struct Location {
+            size_t offset = 0;      // Of the compressed bytes in the mapping
+            uint32_t rawSize = 0;
+            uint32_t compressedSize = 0;
+        };
+
+        bool CreateEmpty(const std::string& path);
+        void BuildIndex();
+
+        MappedFile m_Mapping;
+        std::unordered_map<uint64_t, Location> m_Index;     // Read-only after Open()
+        std::ofstream m_Writer;
+        std::mutex m_WriteMutex;
+
+        static constexpr uint32_t s_Version = 3;    // 3: one field per SVG, keyed by its hash
+        static constexpr uint32_t s_EntryMagic = 0x4E434955;   // "UICN"
+        static constexpr size_t s_MaxFileSize = 16 * 1024 * 1024;
+    };
+
+} // namespace Unicorn::UI
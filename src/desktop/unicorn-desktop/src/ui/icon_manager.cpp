@@ -1,33 +1,125 @@
 ﻿#include "icon_manager.h"
+#include "icon_disk_cache.h"
+#include "icon_sdf.h"
+#include "../core/application.h"
 #include <glad/glad.h>
-#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
-#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
-#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
-#endif
 #include <iostream>
+#include <fstream>
+#include <filesystem>
 #include <chrono>
+#include <cmath>
 
 #define NANOSVG_IMPLEMENTATION
 #include "nanosvg.h"
-#define NANOSVGRAST_IMPLEMENTATION
-#include "nanosvgrast.h"
 
 namespace Unicorn::UI {
 
     // ========================================
-    // CRITICAL: Icon cache to avoid re-rasterization
+    // CRITICAL: Icon cache to avoid regenerating fields
     // ========================================
+    // One field per icon serves every draw size. Only touched on the GL thread.
     struct CachedIconData {
-        std::vector<unsigned char> pixels;
+        std::vector<unsigned char> field;
         int width;
         int height;
-        bool generated;
     };
 
     static std::unordered_map<std::string, CachedIconData> s_IconCache;
-    static bool s_IconsPreGenerated = false;
 
-    IconManager::IconManager() {}
+    // ========================================
+    // Icon atlas
+    // ========================================
+
+    bool IconAtlas::Create() {
+        if (!AddPage()) return false;
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return true;
+    }
+
+    bool IconAtlas::AddPage() {
+        // Leaves the new page bound: it is started in the middle of an upload
+        uint32_t page = 0;
+        glGenTextures(1, &page);
+        if (page == 0) return false;
+        glBindTexture(GL_TEXTURE_2D, page);
+
+        // Start at the far outside distance so gutters sample as empty
+        std::vector<unsigned char> clearData(width * height, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0,
+            GL_RED, GL_UNSIGNED_BYTE, clearData.data());
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        pages.push_back(page);
+        textureID = page;
+        currentX = Padding;
+        currentY = Padding;
+        rowHeight = 0;
+        return true;
+    }
+
+    void IconAtlas::Destroy() {
+        if (!pages.empty()) {
+            glDeleteTextures(static_cast<GLsizei>(pages.size()), pages.data());
+            pages.clear();
+        }
+        textureID = 0;
+        currentX = currentY = rowHeight = 0;
+    }
+
+    void IconAtlas::BeginUpload() {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+    }
+
+    void IconAtlas::EndUpload() {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    bool IconAtlas::AddIcon(uint32_t iconWidth, uint32_t iconHeight,
+        const unsigned char* fieldData,
+        glm::vec2& outUVMin, glm::vec2& outUVMax) {
+        uint32_t cellWidth = iconWidth + Padding;
+        uint32_t cellHeight = iconHeight + Padding;
+
+        if (currentX + cellWidth > width) {
+            currentX = Padding;
+            currentY += rowHeight;
+            rowHeight = 0;
+        }
+
+        if (textureID == 0) return false;
+
+        if (currentY + cellHeight > height) {
+            if (!AddPage()) {
+                std::cerr << "[IconAtlas] Failed to add an atlas page" << std::endl;
+                return false;
+            }
+            std::cout << "[IconAtlas] Started page " << pages.size() << std::endl;
+        }
+
+        glTexSubImage2D(GL_TEXTURE_2D, 0, currentX, currentY, iconWidth, iconHeight,
+            GL_RED, GL_UNSIGNED_BYTE, fieldData);
+
+        outUVMin = glm::vec2((float)currentX / (float)width, (float)currentY / (float)height);
+        outUVMax = glm::vec2((float)(currentX + iconWidth) / (float)width,
+            (float)(currentY + iconHeight) / (float)height);
+
+        currentX += cellWidth;
+        rowHeight = glm::max(rowHeight, cellHeight);
+
+        return true;
+    }
+
+    // ========================================
+    // IconManager
+    // ========================================
+
+    IconManager::IconManager()
+        : m_DiskCache(std::make_unique<IconDiskCache>()) {}
 
     IconManager::~IconManager() {
         Shutdown();
@@ -36,198 +128,374 @@ namespace Unicorn::UI {
     bool IconManager::Init() {
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        // ========================================
-        // Pre-generate all icons ONCE at startup
-        // ========================================
-        if (!s_IconsPreGenerated) {
-            std::cout << "[IconManager] Pre-generating icon textures..." << std::endl;
-            PreGenerateAllIcons();
-            s_IconsPreGenerated = true;
+        if (!m_Atlas.Create()) {
+            std::cerr << "[IconManager] Failed to create icon atlas" << std::endl;
+            return false;
         }
 
-        // Load from cache (instant)
+        // Fields from previous launches; SVGs are still read to check their hash
+        m_DiskCache->Open("cache/icons.bin");
+
+        // Only records where each icon comes from; fields are produced on a
+        // worker when an icon is first drawn, so this is independent of pack size
         LoadBuiltInIcons();
 
+        std::error_code ec;
+        if (std::filesystem::is_directory("assets/icons", ec)) {
+            LoadIconDirectory("assets/icons");
+        }
+        if (std::filesystem::is_regular_file("assets/icons.pack", ec)) {
+            LoadIconPack("assets/icons.pack");
+        }
+
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
 
-        std::cout << "[IconManager] Initialized with " << m_Icons.size()
+        std::cout << "[IconManager] Initialized with " << m_Sources.size()
             << " icons in " << duration.count() << "ms" << std::endl;
         return true;
     }
 
     void IconManager::Shutdown() {
-        for (auto& [name, icon] : m_Icons) {
-            if (icon.textureID) {
-                glDeleteTextures(1, &icon.textureID);
-            }
-        }
+        StopWorkers();
+        m_DiskCache->Close();
+
+        m_Atlas.Destroy();
         m_Icons.clear();
+        m_Pending.clear();
+        m_Failed.clear();
 
         // Keep s_IconCache alive for fast reload
         std::cout << "[IconManager] Shutdown (cache retained for fast reload)" << std::endl;
     }
 
-    void IconManager::PreGenerateAllIcons() {
-        // Pre-generate all built-in icons at high quality
-        const int iconSize = 20;
+    // ========================================
+    // Icon sources
+    // ========================================
 
-        struct IconDef {
-            const char* name;
-            const char* svg;
-        };
+    bool IconManager::RegisterIcon(const std::string& name, IconSource source) {
+        // First registration wins, so built-ins cannot be shadowed by a pack
+        return m_Sources.emplace(name, std::move(source)).second;
+    }
 
-        IconDef icons[] = {
-            {"add", Icons::Add},
-            {"settings", Icons::Settings},
-            {"close", Icons::Close},
-            {"report", Icons::Report},
-            {"person", Icons::Person}
-        };
+    bool IconManager::HasIcon(const std::string& name) const {
+        return m_Sources.find(name) != m_Sources.end();
+    }
+
+    size_t IconManager::LoadIconDirectory(const std::string& directory) {
+        namespace fs = std::filesystem;
+
+        size_t count = 0;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            if (!entry.is_regular_file(ec) || entry.path().extension() != ".svg") {
+                continue;
+            }
 
-        for (const auto& iconDef : icons) {
-            if (s_IconCache.find(iconDef.name) == s_IconCache.end()) {
-                std::cout << "[IconManager]   Pre-rasterizing: " << iconDef.name << std::endl;
-                PreRasterizeIcon(iconDef.name, iconDef.svg, iconSize);
+            IconSource source;
+            source.path = entry.path().string();
+            if (RegisterIcon(entry.path().stem().string(), std::move(source))) {
+                count++;
             }
         }
+
+        if (ec) {
+            std::cerr << "[IconManager] Failed to read icon directory " << directory
+                << ": " << ec.message() << std::endl;
+        }
+
+        std::cout << "[IconManager] Registered " << count << " icons from " << directory << std::endl;
+        return count;
     }
 
-    void IconManager::PreRasterizeIcon(const std::string& name, const std::string& svgContent, int size) {
-        // Parse SVG
-        NSVGimage* image = nsvgParse((char*)svgContent.c_str(), "px", 96.0f);
-        if (!image) {
-            std::cerr << "[IconManager] Failed to parse SVG: " << name << std::endl;
-            return;
+    size_t IconManager::LoadIconPack(const std::string& packPath) {
+        std::ifstream file(packPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "[IconManager] Failed to open icon pack: " << packPath << std::endl;
+            return 0;
         }
 
-        // 8x supersampling for ultra-crisp icons
-        int supersampleFactor = 8;
-        int renderSize = size * supersampleFactor;
+        std::string header;
+        std::getline(file, header);
+        if (header.rfind("UNICORN-ICONS 1", 0) != 0) {
+            std::cerr << "[IconManager] Not an icon pack: " << packPath << std::endl;
+            return 0;
+        }
 
-        // Calculate scale
-        float scale = (float)renderSize / std::max(image->width, image->height);
+        // Walk the record headers and seek past each SVG body
+        size_t count = 0;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
 
-        int channels = 4; // RGBA
-        std::vector<unsigned char> pixels(renderSize * renderSize * channels, 0);
+            size_t space = line.rfind(' ');
+            if (space == std::string::npos || space == 0) {
+                std::cerr << "[IconManager] Corrupt icon pack record in " << packPath << std::endl;
+                break;
+            }
 
-        NSVGrasterizer* rast = nsvgCreateRasterizer();
+            IconSource source;
+            source.path = packPath;
+            source.offset = static_cast<uint64_t>(file.tellg());
+            source.length = std::strtoull(line.c_str() + space + 1, nullptr, 10);
 
-        nsvgRasterize(rast, image, 0, 0, scale, pixels.data(),
-            renderSize, renderSize, renderSize * channels);
+            if (source.length == 0) break;
+            if (RegisterIcon(line.substr(0, space), source)) {
+                count++;
+            }
 
-        // Premultiply alpha for correct blending
-        for (int i = 0; i < renderSize * renderSize; i++) {
-            int idx = i * 4;
-            float alpha = pixels[idx + 3] / 255.0f;
-            pixels[idx + 0] = (unsigned char)(pixels[idx + 0] * alpha); // R
-            pixels[idx + 1] = (unsigned char)(pixels[idx + 1] * alpha); // G
-            pixels[idx + 2] = (unsigned char)(pixels[idx + 2] * alpha); // B
+            file.seekg(static_cast<std::streamoff>(source.length), std::ios::cur);
         }
 
-        // Store in cache
-        CachedIconData cached;
-        cached.pixels = std::move(pixels);
-        cached.width = renderSize;
-        cached.height = renderSize;
-        cached.generated = true;
-        s_IconCache[name] = std::move(cached);
+        std::cout << "[IconManager] Registered " << count << " icons from " << packPath << std::endl;
+        return count;
+    }
 
-        // Cleanup
-        nsvgDeleteRasterizer(rast);
-        nsvgDelete(image);
+    // ========================================
+    // Worker pool
+    // ========================================
+
+    void IconManager::StartWorkers() {
+        if (!m_Workers.empty()) return;
+
+        unsigned int hardware = std::thread::hardware_concurrency();
+        unsigned int count = std::clamp(hardware > 1 ? hardware - 1 : 1u, 1u, 4u);
+
+        m_StopWorkers = false;
+        for (unsigned int i = 0; i < count; i++) {
+            m_Workers.emplace_back(&IconManager::WorkerLoop, this);
+        }
     }
 
-    uint32_t IconManager::RasterizeSVG(const std::string& svgContent, int size) {
-        // ❌ OLD: This was called every Init()
-        // Now we use cached data instead!
-        return 0; // Deprecated
+    void IconManager::StopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(m_QueueMutex);
+            m_StopWorkers = true;
+            m_Jobs.clear();
+        }
+        m_QueueCondition.notify_all();
+
+        for (auto& worker : m_Workers) {
+            if (worker.joinable()) worker.join();
+        }
+        m_Workers.clear();
+        m_Finished.clear();
+        m_UploadsPending = false;
     }
 
-    uint32_t IconManager::CreateTextureFromCache(const std::string& name) {
-        auto it = s_IconCache.find(name);
-        if (it == s_IconCache.end() || !it->second.generated) {
-            std::cerr << "[IconManager] Icon not in cache: " << name << std::endl;
-            return 0;
+    void IconManager::WorkerLoop() {
+        while (true) {
+            FieldJob job;
+            {
+                std::unique_lock<std::mutex> lock(m_QueueMutex);
+                m_QueueCondition.wait(lock, [this]() { return m_StopWorkers || !m_Jobs.empty(); });
+                if (m_StopWorkers) return;
+
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+
+            FieldResult result;
+            result.name = job.name;
+            if (!GenerateField(job, result)) {
+                result.field.clear();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_QueueMutex);
+                if (m_StopWorkers) return;
+                m_Finished.push_back(std::move(result));
+            }
+
+            // Set after the push, so a batch swapped out by ProcessUploads
+            // before this field arrived still leaves the flag for the next
+            // loop; only the main loop marks the UI dirty
+            if (!m_UploadsPending.exchange(true)) {
+                Application::WakeMainLoop();
+            }
         }
+    }
 
-        const auto& cached = it->second;
+    bool IconManager::GenerateField(const FieldJob& job, FieldResult& result) {
+        std::string svg = job.source.svg;
 
-        // Create OpenGL texture from cached pixel data
-        uint32_t texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        if (svg.empty() && !job.source.path.empty()) {
+            std::ifstream file(job.source.path, std::ios::binary);
+            if (!file) {
+                std::cerr << "[IconManager] Failed to open " << job.source.path << std::endl;
+                return false;
+            }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
-            cached.width, cached.height, 0,
-            GL_RGBA, GL_UNSIGNED_BYTE, cached.pixels.data());
+            if (job.source.length > 0) {
+                svg.resize(job.source.length);
+                file.seekg(static_cast<std::streamoff>(job.source.offset));
+                file.read(svg.data(), static_cast<std::streamsize>(svg.size()));
+                if (file.gcount() != static_cast<std::streamsize>(svg.size())) {
+                    return false;
+                }
+            }
+            else {
+                svg.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+        }
 
-        // Generate mipmaps for smooth scaling
-        glGenerateMipmap(GL_TEXTURE_2D);
+        // Same SVG bytes: reuse the stored field
+        uint64_t svgHash = IconDiskCache::HashSVG(svg);
+        if (m_DiskCache->Load(svgHash, result.field)) {
+            return true;
+        }
 
-        // High-quality filtering
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // nsvgParse modifies its (NUL-terminated) input in place
+        NSVGimage* image = nsvgParse(svg.data(), "px", 96.0f);
+        if (!image) {
+            std::cerr << "[IconManager] Failed to parse SVG: " << job.name << std::endl;
+            return false;
+        }
 
-        // Anisotropic filtering (if available)
-        float maxAnisotropy;
-        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT,
-            glm::min(maxAnisotropy, 16.0f));
+        bool generated = GenerateIconSDF(image, result.field);
+        nsvgDelete(image);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        if (!generated) {
+            std::cerr << "[IconManager] SVG has no visible shapes: " << job.name << std::endl;
+            return false;
+        }
 
-        // Sharpen mipmap transitions
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, -0.5f);
+        m_DiskCache->Store(svgHash, result.field);
+        return true;
+    }
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    size_t IconManager::ProcessUploads() {
+        m_UploadsPending = false;
 
-        return texture;
+        std::vector<FieldResult> finished;
+        {
+            std::lock_guard<std::mutex> lock(m_QueueMutex);
+            if (m_Finished.empty()) return 0;
+            finished.swap(m_Finished);
+        }
+
+        size_t uploaded = 0;
+        m_Atlas.BeginUpload();
+
+        for (auto& result : finished) {
+            m_Pending.erase(result.name);
+
+            if (result.field.empty()) {
+                m_Failed.insert(result.name);
+                continue;
+            }
+
+            CachedIconData cached;
+            cached.field = std::move(result.field);
+            cached.width = IconSDFLayout::Size;
+            cached.height = IconSDFLayout::Size;
+            s_IconCache[result.name] = std::move(cached);
+
+            // A field that could not be packed stays cached, so the next
+            // GetIcon tries again instead of giving up on the icon
+            Icon icon;
+            if (AddToAtlasFromCache(result.name, icon)) {
+                m_Icons[result.name] = icon;
+                uploaded++;
+            }
+        }
+
+        m_Atlas.EndUpload();
+        return uploaded;
     }
 
-    bool IconManager::LoadIconFromString(const std::string& name, const std::string& svgContent, int size) {
-        // Check if already in cache
-        if (s_IconCache.find(name) == s_IconCache.end()) {
-            // Not cached - generate now (only happens for dynamic icons)
-            PreRasterizeIcon(name, svgContent, size);
+    bool IconManager::AddToAtlasFromCache(const std::string& name, Icon& outIcon) {
+        auto it = s_IconCache.find(name);
+        if (it == s_IconCache.end()) {
+            std::cerr << "[IconManager] Icon not in cache: " << name << std::endl;
+            return false;
         }
 
-        // Create texture from cache
-        uint32_t texture = CreateTextureFromCache(name);
-        if (texture == 0) {
+        const auto& cached = it->second;
+
+        // Pack the cached field into the shared atlas
+        glm::vec2 uvMin, uvMax;
+        if (!m_Atlas.AddIcon(cached.width, cached.height, cached.field.data(), uvMin, uvMax)) {
             return false;
         }
 
-        Icon icon;
-        icon.textureID = texture;
-        icon.width = size;
-        icon.height = size;
-        m_Icons[name] = icon;
+        // Quads cover the view box; the border only feeds the falloff
+        glm::vec2 inset = (uvMax - uvMin) * ((float)IconSDFLayout::Border / (float)IconSDFLayout::Size);
+        outIcon.textureID = m_Atlas.textureID;
+        outIcon.uvMin = uvMin + inset;
+        outIcon.uvMax = uvMax - inset;
+        return true;
+    }
+
+    bool IconManager::LoadIconFromString(const std::string& name, const std::string& svgContent) {
+        IconSource source;
+        source.svg = svgContent;
+        if (!RegisterIcon(name, std::move(source)) && !HasIcon(name)) {
+            return false;
+        }
 
+        // Generate the field in the background
+        GetIcon(name);
         return true;
     }
 
-    const IconManager::Icon* IconManager::GetIcon(const std::string& name) const {
+    const IconManager::Icon* IconManager::GetIcon(const std::string& name) {
         auto it = m_Icons.find(name);
         if (it != m_Icons.end()) {
             return &it->second;
         }
+
+        if (m_Pending.count(name) || m_Failed.count(name)) {
+            return nullptr;
+        }
+
+        // Generated before (e.g. before a Shutdown/Init cycle): just repack
+        if (s_IconCache.find(name) != s_IconCache.end()) {
+            Icon icon;
+            m_Atlas.BeginUpload();
+            bool added = AddToAtlasFromCache(name, icon);
+            m_Atlas.EndUpload();
+
+            if (!added) return nullptr;
+            return &m_Icons.emplace(name, icon).first->second;
+        }
+
+        auto source = m_Sources.find(name);
+        if (source == m_Sources.end()) {
+            std::cerr << "[IconManager] Unknown icon: " << name << std::endl;
+            m_Failed.insert(name);
+            return nullptr;
+        }
+
+        StartWorkers();
+        m_Pending.insert(name);
+        {
+            std::lock_guard<std::mutex> lock(m_QueueMutex);
+            m_Jobs.push_back({ name, source->second });
+        }
+        m_QueueCondition.notify_one();
+
         return nullptr;
     }
 
     void IconManager::LoadBuiltInIcons() {
-        // ✅ Load from pre-generated cache (instant!)
-        LoadIconFromString("add", Icons::Add, 20);
-        LoadIconFromString("settings", Icons::Settings, 20);
-        LoadIconFromString("close", Icons::Close, 20);
-        LoadIconFromString("report", Icons::Report, 20);
-        LoadIconFromString("person", Icons::Person, 20);
+        const std::pair<const char*, const char*> builtIns[] = {
+            {"add", Icons::Add},
+            {"settings", Icons::Settings},
+            {"close", Icons::Close},
+            {"report", Icons::Report},
+            {"person", Icons::Person}
+        };
+
+        for (const auto& [name, svg] : builtIns) {
+            IconSource source;
+            source.svg = svg;
+            RegisterIcon(name, std::move(source));
+        }
     }
 
     void IconManager::ClearCache() {
         s_IconCache.clear();
-        s_IconsPreGenerated = false;
         std::cout << "[IconManager] Cache cleared" << std::endl;
     }
 
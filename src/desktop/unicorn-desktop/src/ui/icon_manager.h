@@ -2,17 +2,68 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <unordered_set>
 #include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace Unicorn::UI {
 
+    class IconDiskCache;
+
+    // Shared single-channel textures holding every icon's distance field, so
+    // icon quads go through the shape batch instead of binding a texture per
+    // icon. Fields carry their own border, so a one-texel gutter is enough to
+    // keep bilinear taps inside each icon. A page holds 225 fields; when it
+    // fills, another page is started, and the batch only breaks where
+    // consecutive icons live on different pages.
+    struct IconAtlas {
+        static constexpr uint32_t Padding = 1;
+
+        std::vector<uint32_t> pages;    // Textures, in the order they were filled
+        uint32_t textureID = 0;         // The page being filled
+        uint32_t width = 1024;
+        uint32_t height = 1024;
+        uint32_t currentX = 0;
+        uint32_t currentY = 0;
+        uint32_t rowHeight = 0;
+
+        bool Create();
+        void Destroy();
+
+        // AddIcon calls go between BeginUpload/EndUpload so a batch binds once.
+        // The field lands on textureID as it is after the call.
+        void BeginUpload();
+        bool AddIcon(uint32_t iconWidth, uint32_t iconHeight,
+            const unsigned char* fieldData,
+            glm::vec2& outUVMin, glm::vec2& outUVMax);
+        void EndUpload();
+
+    private:
+        bool AddPage();
+    };
+
+    // Where an icon's SVG text comes from. Registering only records this;
+    // the bytes are read and parsed by a worker when the icon is first drawn.
+    struct IconSource {
+        std::string svg;            // Embedded SVG, or empty
+        std::string path;           // .svg file or icon pack
+        uint64_t offset = 0;        // Byte range within a pack
+        uint64_t length = 0;        // 0 = whole file
+    };
+
     class IconManager {
     public:
         struct Icon {
-            uint32_t textureID;
-            int width;
-            int height;
+            uint32_t textureID;     // Atlas texture (shared by all icons)
+            glm::vec2 uvMin;        // The SVG view box within the field
+            glm::vec2 uvMax;
         };
 
         IconManager();
@@ -21,30 +72,75 @@ namespace Unicorn::UI {
         bool Init();
         void Shutdown();
 
-        // Load icon from SVG file or embedded string
-        bool LoadIconFromString(const std::string& name, const std::string& svgContent, int size = 24);
-
-        // Get icon texture
-        const Icon* GetIcon(const std::string& name) const;
+        // Register an icon from an SVG string and queue its distance field
+        bool LoadIconFromString(const std::string& name, const std::string& svgContent);
+
+        // Register every *.svg in 'directory' under its file name (without
+        // extension). Only the directory listing happens here.
+        size_t LoadIconDirectory(const std::string& directory);
+
+        // Register every icon in a pack file: a "UNICORN-ICONS 1" line, then
+        // per icon a "<name> <byte length>" line followed by the SVG bytes.
+        // Only the record headers are read here.
+        size_t LoadIconPack(const std::string& packPath);
+
+        // Distance field of an icon, drawable at any size. The first request
+        // queues field generation on the worker pool and returns nullptr; the
+        // icon is available once a later ProcessUploads has packed it (a
+        // redraw is triggered when it is ready).
+        const Icon* GetIcon(const std::string& name);
+        bool HasIcon(const std::string& name) const;
+        // Set by the workers when fields are waiting; the main loop reads it
+        // before deciding whether to draw, so the redraw that uploads them is
+        // marked dirty on the UI thread
+        bool HasPendingUploads() const { return m_UploadsPending; }
+
+        // GL thread, once per frame: pack finished fields into the atlas in
+        // one batch. Returns the number of icons uploaded.
+        size_t ProcessUploads();
 
         // Built-in icons (Material Design style)
         void LoadBuiltInIcons();
 
-        // Clear pre-generated cache (for testing)
+        // Clear generated field cache (for testing)
         static void ClearCache();
 
     private:
-        std::unordered_map<std::string, Icon> m_Icons;
+        // Fields are generated once at IconSDFLayout::Size and scaled on the
+        // GPU, so an icon's name is all that identifies one
+        struct FieldJob {
+            std::string name;
+            IconSource source;
+        };
+
+        struct FieldResult {
+            std::string name;
+            std::vector<unsigned char> field;   // Empty on failure
+        };
+
+        bool RegisterIcon(const std::string& name, IconSource source);
+        bool AddToAtlasFromCache(const std::string& name, Icon& outIcon);
 
-        // ========================================
-        // OPTIMIZED: Pre-generation system
-        // ========================================
-        void PreGenerateAllIcons();
-        void PreRasterizeIcon(const std::string& name, const std::string& svgContent, int size);
-        uint32_t CreateTextureFromCache(const std::string& name);
+        void StartWorkers();
+        void StopWorkers();
+        void WorkerLoop();
+        bool GenerateField(const FieldJob& job, FieldResult& result);
 
-        // Deprecated (kept for compatibility)
-        uint32_t RasterizeSVG(const std::string& svgContent, int size);
+        std::unordered_map<std::string, Icon> m_Icons;
+        std::unordered_map<std::string, IconSource> m_Sources;
+        std::unordered_set<std::string> m_Pending;
+        std::unordered_set<std::string> m_Failed;
+        IconAtlas m_Atlas;
+        std::unique_ptr<IconDiskCache> m_DiskCache;
+
+        // Worker pool, started on the first field request
+        std::vector<std::thread> m_Workers;
+        std::mutex m_QueueMutex;
+        std::condition_variable m_QueueCondition;
+        std::deque<FieldJob> m_Jobs;
+        std::vector<FieldResult> m_Finished;
+        std::atomic<bool> m_UploadsPending{ false };
+        bool m_StopWorkers = false;
     };
 
     // Built-in SVG icons as strings
@@ -0,0 +1,164 @@
+#include "icon_sdf.h"
+#include "nanosvg.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Unicorn::UI {
+
+    namespace {
+
+        struct Segment {
+            glm::vec2 a;
+            glm::vec2 b;
+        };
+
+        struct FlatShape {
+            std::vector<Segment> outline;   // Closed contours for the fill
+            std::vector<Segment> stroke;    // Open or closed centre lines
+            bool fill = false;
+            bool evenOdd = false;
+            float halfStroke = 0.0f;        // In field texels
+        };
+
+        float DistanceToSegment(const glm::vec2& p, const Segment& s) {
+            glm::vec2 ab = s.b - s.a;
+            float lengthSq = glm::dot(ab, ab);
+            float t = lengthSq > 0.0f ? glm::clamp(glm::dot(p - s.a, ab) / lengthSq, 0.0f, 1.0f) : 0.0f;
+            return glm::length(p - (s.a + ab * t));
+        }
+
+        // Non-zero winding contribution of a segment for a ray cast towards +x
+        int Winding(const glm::vec2& p, const Segment& s) {
+            if (s.a.y <= p.y) {
+                if (s.b.y > p.y) {
+                    float cross = (s.b.x - s.a.x) * (p.y - s.a.y) - (p.x - s.a.x) * (s.b.y - s.a.y);
+                    if (cross > 0.0f) return 1;
+                }
+            }
+            else if (s.b.y <= p.y) {
+                float cross = (s.b.x - s.a.x) * (p.y - s.a.y) - (p.x - s.a.x) * (s.b.y - s.a.y);
+                if (cross < 0.0f) return -1;
+            }
+            return 0;
+        }
+
+        void FlattenCubic(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2,
+            const glm::vec2& p3, std::vector<Segment>& out) {
+            // Roughly one segment per texel of control polygon length
+            float length = glm::length(p1 - p0) + glm::length(p2 - p1) + glm::length(p3 - p2);
+            int steps = std::clamp(static_cast<int>(std::ceil(length)), 1, 64);
+
+            glm::vec2 previous = p0;
+            for (int i = 1; i <= steps; i++) {
+                float t = (float)i / (float)steps;
+                float u = 1.0f - t;
+                glm::vec2 point = u * u * u * p0 + 3.0f * u * u * t * p1 +
+                    3.0f * u * t * t * p2 + t * t * t * p3;
+                out.push_back({ previous, point });
+                previous = point;
+            }
+        }
+
+    } // namespace
+
+    bool GenerateIconSDF(const NSVGimage* image, std::vector<unsigned char>& outField) {
+        constexpr int size = IconSDFLayout::Size;
+        constexpr int border = IconSDFLayout::Border;
+        constexpr float range = IconSDFLayout::Range;
+
+        if (!image || image->width <= 0.0f || image->height <= 0.0f) {
+            return false;
+        }
+
+        // View box -> field texels, centered in the inner square
+        float inner = (float)(size - 2 * border);
+        float scale = inner / std::max(image->width, image->height);
+        glm::vec2 offset(
+            border + (inner - image->width * scale) * 0.5f,
+            border + (inner - image->height * scale) * 0.5f);
+
+        std::vector<FlatShape> shapes;
+        for (const NSVGshape* shape = image->shapes; shape; shape = shape->next) {
+            if (!(shape->flags & NSVG_FLAGS_VISIBLE) || shape->opacity <= 0.0f) continue;
+
+            FlatShape flat;
+            flat.fill = shape->fill.type != NSVG_PAINT_NONE;
+            flat.evenOdd = shape->fillRule == NSVG_FILLRULE_EVENODD;
+            if (shape->stroke.type != NSVG_PAINT_NONE && shape->strokeWidth > 0.0f) {
+                flat.halfStroke = shape->strokeWidth * scale * 0.5f;
+            }
+            if (!flat.fill && flat.halfStroke <= 0.0f) continue;
+
+            for (const NSVGpath* path = shape->paths; path; path = path->next) {
+                if (path->npts < 1) continue;
+
+                std::vector<Segment> segments;
+                auto point = [&](int index) {
+                    return glm::vec2(path->pts[index * 2], path->pts[index * 2 + 1]) * scale + offset;
+                };
+
+                for (int i = 0; i + 3 < path->npts; i += 3) {
+                    FlattenCubic(point(i), point(i + 1), point(i + 2), point(i + 3), segments);
+                }
+
+                glm::vec2 first = point(0);
+                glm::vec2 last = segments.empty() ? first : segments.back().b;
+
+                if (flat.halfStroke > 0.0f) {
+                    flat.stroke.insert(flat.stroke.end(), segments.begin(), segments.end());
+                    if (path->closed && last != first) flat.stroke.push_back({ last, first });
+                }
+                if (flat.fill) {
+                    // Fills are implicitly closed
+                    flat.outline.insert(flat.outline.end(), segments.begin(), segments.end());
+                    if (last != first) flat.outline.push_back({ last, first });
+                }
+            }
+
+            shapes.push_back(std::move(flat));
+        }
+
+        if (shapes.empty()) {
+            return false;
+        }
+
+        outField.assign(static_cast<size_t>(size) * size, 0);
+
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                glm::vec2 p((float)x + 0.5f, (float)y + 0.5f);
+
+                // Union of all shapes: the largest signed distance wins
+                float best = -range;
+                for (const FlatShape& shape : shapes) {
+                    if (shape.fill && !shape.outline.empty()) {
+                        float nearest = range * 2.0f;
+                        int winding = 0;
+                        for (const Segment& segment : shape.outline) {
+                            nearest = std::min(nearest, DistanceToSegment(p, segment));
+                            winding += Winding(p, segment);
+                        }
+                        bool inside = shape.evenOdd ? (winding & 1) != 0 : winding != 0;
+                        best = std::max(best, inside ? nearest : -nearest);
+                    }
+
+                    if (shape.halfStroke > 0.0f) {
+                        float nearest = shape.halfStroke + range * 2.0f;
+                        for (const Segment& segment : shape.stroke) {
+                            nearest = std::min(nearest, DistanceToSegment(p, segment));
+                        }
+                        best = std::max(best, shape.halfStroke - nearest);
+                    }
+                }
+
+                float encoded = 0.5f + 0.5f * glm::clamp(best / range, -1.0f, 1.0f);
+                outField[static_cast<size_t>(y) * size + x] =
+                    static_cast<unsigned char>(std::lround(encoded * 255.0f));
+            }
+        }
+
+        return true;
+    }
+
+} // namespace Unicorn::UI
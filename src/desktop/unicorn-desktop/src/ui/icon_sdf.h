@@ -0,0 +1,23 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+struct NSVGimage;
+
+namespace Unicorn::UI {
+
+    // Layout of a per-icon signed distance field. The SVG's view box is fitted
+    // into the inner (Size - 2 * Border) square; the border lets the field
+    // fall off smoothly around shapes that touch the view box edge.
+    struct IconSDFLayout {
+        static constexpr int Size = 64;
+        static constexpr int Border = 4;
+        static constexpr float Range = 4.0f;    // Texels mapped onto [0, 255]
+    };
+
+    // Convert the visible fills and strokes of a parsed SVG into an 8-bit
+    // distance field (128 = edge, larger = inside). Curves are flattened once;
+    // fills honour the shape's fill rule, strokes use round caps and joins.
+    bool GenerateIconSDF(const NSVGimage* image, std::vector<unsigned char>& outField);
+
+} // namespace Unicorn::UI
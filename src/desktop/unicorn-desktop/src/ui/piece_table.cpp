@@ -0,0 +1,247 @@
+#include "piece_table.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Unicorn::UI {
+
+    static void IndexBreaks(const std::string& buffer, size_t from, std::vector<size_t>& breaks) {
+        const char* data = buffer.data();
+        const char* end = data + buffer.size();
+        const char* it = data + from;
+
+        while (it < end) {
+            const void* found = std::memchr(it, '\n', end - it);
+            if (!found) break;
+            const char* newline = static_cast<const char*>(found);
+            breaks.push_back(newline - data);
+            it = newline + 1;
+        }
+    }
+
+    PieceTable::PieceTable(std::string text)
+        : m_Original(std::move(text)) {
+        IndexBreaks(m_Original, 0, m_OriginalBreaks);
+
+        if (!m_Original.empty()) {
+            m_Pieces.push_back(MakePiece(Source::Original, 0, m_Original.size()));
+        }
+
+        m_Length = m_Original.size();
+        m_LineBreaks = m_OriginalBreaks.size();
+    }
+
+    size_t PieceTable::CountBreaks(Source source, size_t start, size_t length) const {
+        const auto& breaks = Breaks(source);
+        auto first = std::lower_bound(breaks.begin(), breaks.end(), start);
+        auto last = std::lower_bound(first, breaks.end(), start + length);
+        return static_cast<size_t>(last - first);
+    }
+
+    PieceTable::Piece PieceTable::MakePiece(Source source, size_t start, size_t length) const {
+        Piece piece;
+        piece.source = source;
+        piece.start = start;
+        piece.length = length;
+        piece.lineBreaks = CountBreaks(source, start, length);
+        return piece;
+    }
+
+    size_t PieceTable::FindPiece(size_t offset, size_t& pieceOffset) const {
+        size_t pos = 0;
+        for (size_t i = 0; i < m_Pieces.size(); i++) {
+            if (offset <= pos + m_Pieces[i].length) {
+                pieceOffset = pos;
+                return i;
+            }
+            pos += m_Pieces[i].length;
+        }
+
+        pieceOffset = pos;
+        return m_Pieces.size();
+    }
+
+    // ============================================================================
+    // EDITING
+    // ============================================================================
+
+    void PieceTable::Insert(size_t offset, std::string_view text) {
+        if (text.empty()) return;
+        offset = std::min(offset, m_Length);
+
+        size_t addStart = m_Add.size();
+        size_t breaksBefore = m_AddBreaks.size();
+        m_Add.append(text.data(), text.size());
+        IndexBreaks(m_Add, addStart, m_AddBreaks);
+
+        Piece inserted;
+        inserted.source = Source::Add;
+        inserted.start = addStart;
+        inserted.length = text.size();
+        inserted.lineBreaks = m_AddBreaks.size() - breaksBefore;
+
+        m_Length += inserted.length;
+        m_LineBreaks += inserted.lineBreaks;
+
+        if (m_Pieces.empty()) {
+            m_Pieces.push_back(inserted);
+            return;
+        }
+
+        size_t pieceOffset = 0;
+        size_t index = FindPiece(offset, pieceOffset);
+        Piece& target = m_Pieces[index];
+        size_t local = offset - pieceOffset;
+
+        if (local == target.length) {
+            // Typing right after the previous insertion extends that piece,
+            // so a burst of keystrokes stays a single piece
+            if (target.source == Source::Add && target.start + target.length == addStart) {
+                target.length += inserted.length;
+                target.lineBreaks += inserted.lineBreaks;
+                return;
+            }
+            m_Pieces.insert(m_Pieces.begin() + index + 1, inserted);
+        }
+        else if (local == 0) {
+            m_Pieces.insert(m_Pieces.begin() + index, inserted);
+        }
+        else {
+            Piece left = MakePiece(target.source, target.start, local);
+            Piece right = MakePiece(target.source, target.start + local, target.length - local);
+            m_Pieces[index] = left;
+            m_Pieces.insert(m_Pieces.begin() + index + 1, { inserted, right });
+        }
+    }
+
+    void PieceTable::Erase(size_t offset, size_t length) {
+        if (offset >= m_Length || length == 0) return;
+        length = std::min(length, m_Length - offset);
+        size_t end = offset + length;
+
+        std::vector<Piece> pieces;
+        pieces.reserve(m_Pieces.size() + 1);
+
+        size_t pos = 0;
+        for (const auto& piece : m_Pieces) {
+            size_t pieceEnd = pos + piece.length;
+
+            if (pieceEnd <= offset || pos >= end) {
+                pieces.push_back(piece);
+            }
+            else {
+                if (pos < offset) {
+                    pieces.push_back(MakePiece(piece.source, piece.start, offset - pos));
+                }
+                if (pieceEnd > end) {
+                    size_t skip = end - pos;
+                    pieces.push_back(MakePiece(piece.source, piece.start + skip, piece.length - skip));
+                }
+            }
+
+            pos = pieceEnd;
+        }
+
+        m_Pieces.swap(pieces);
+        m_Length -= length;
+
+        m_LineBreaks = 0;
+        for (const auto& piece : m_Pieces) {
+            m_LineBreaks += piece.lineBreaks;
+        }
+    }
+
+    void PieceTable::Clear() {
+        m_Original.clear();
+        m_Add.clear();
+        m_OriginalBreaks.clear();
+        m_AddBreaks.clear();
+        m_Pieces.clear();
+        m_Length = 0;
+        m_LineBreaks = 0;
+    }
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    char PieceTable::At(size_t offset) const {
+        size_t pos = 0;
+        for (const auto& piece : m_Pieces) {
+            if (offset < pos + piece.length) {
+                return Buffer(piece.source)[piece.start + (offset - pos)];
+            }
+            pos += piece.length;
+        }
+        return '\0';
+    }
+
+    std::string PieceTable::GetText(size_t offset, size_t length) const {
+        std::string result;
+        if (offset >= m_Length) return result;
+
+        length = std::min(length, m_Length - offset);
+        result.reserve(length);
+        size_t end = offset + length;
+
+        size_t pos = 0;
+        for (const auto& piece : m_Pieces) {
+            size_t pieceEnd = pos + piece.length;
+            if (pieceEnd > offset) {
+                size_t from = std::max(offset, pos);
+                size_t to = std::min(end, pieceEnd);
+                result.append(Buffer(piece.source), piece.start + (from - pos), to - from);
+            }
+            if (pieceEnd >= end) break;
+            pos = pieceEnd;
+        }
+
+        return result;
+    }
+
+    size_t PieceTable::LineStart(size_t line) const {
+        if (line == 0) return 0;
+        if (line > m_LineBreaks) return m_Length;
+
+        // Find the piece holding the line-th newline, then index into it
+        size_t pos = 0;
+        size_t breaks = 0;
+        for (const auto& piece : m_Pieces) {
+            if (breaks + piece.lineBreaks >= line) {
+                const auto& bufferBreaks = Breaks(piece.source);
+                auto first = std::lower_bound(bufferBreaks.begin(), bufferBreaks.end(), piece.start);
+                size_t newline = *(first + (line - breaks - 1));
+                return pos + (newline - piece.start) + 1;
+            }
+            breaks += piece.lineBreaks;
+            pos += piece.length;
+        }
+
+        return m_Length;
+    }
+
+    size_t PieceTable::LineLength(size_t line) const {
+        size_t start = LineStart(line);
+        size_t end = line < m_LineBreaks ? LineStart(line + 1) - 1 : m_Length;
+        return end - start;
+    }
+
+    size_t PieceTable::LineFromOffset(size_t offset) const {
+        size_t pos = 0;
+        size_t breaks = 0;
+        for (const auto& piece : m_Pieces) {
+            if (offset <= pos + piece.length) {
+                return breaks + CountBreaks(piece.source, piece.start, offset - pos);
+            }
+            breaks += piece.lineBreaks;
+            pos += piece.length;
+        }
+        return m_LineBreaks;
+    }
+
+    std::string PieceTable::GetLine(size_t line) const {
+        size_t start = LineStart(line);
+        size_t end = line < m_LineBreaks ? LineStart(line + 1) - 1 : m_Length;
+        return GetText(start, end - start);
+    }
+
+} // namespace Unicorn::UI
@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Unicorn::UI {
+
+    // Piece table text storage. The original text is never copied or moved;
+    // insertions are appended to an add buffer and the document is described
+    // by an ordered list of pieces pointing into either buffer. Newline
+    // positions of both buffers are indexed so line lookups are a walk over
+    // the pieces plus a binary search, independent of the text size.
+    class PieceTable {
+    public:
+        PieceTable() = default;
+        explicit PieceTable(std::string text);
+
+        void Insert(size_t offset, std::string_view text);
+        void Erase(size_t offset, size_t length);
+        void Clear();
+
+        size_t Length() const { return m_Length; }
+        bool Empty() const { return m_Length == 0; }
+        size_t LineCount() const { return m_LineBreaks + 1; }
+        size_t PieceCount() const { return m_Pieces.size(); }
+
+        char At(size_t offset) const;
+        std::string GetText(size_t offset, size_t length) const;
+        std::string ToString() const { return GetText(0, m_Length); }
+
+        // Line queries (lines are separated by '\n', which is not part of the line)
+        size_t LineStart(size_t line) const;
+        size_t LineLength(size_t line) const;
+        size_t LineFromOffset(size_t offset) const;
+        std::string GetLine(size_t line) const;
+
+    private:
+        enum class Source : uint8_t { Original, Add };
+
+        struct Piece {
+            Source source = Source::Original;
+            size_t start = 0;
+            size_t length = 0;
+            size_t lineBreaks = 0;
+        };
+
+        const std::string& Buffer(Source source) const {
+            return source == Source::Original ? m_Original : m_Add;
+        }
+        const std::vector<size_t>& Breaks(Source source) const {
+            return source == Source::Original ? m_OriginalBreaks : m_AddBreaks;
+        }
+
+        // Newlines within [start, start + length) of the piece's buffer
+        size_t CountBreaks(Source source, size_t start, size_t length) const;
+        Piece MakePiece(Source source, size_t start, size_t length) const;
+
+        // Index of the piece containing 'offset' and the piece's document offset.
+        // An offset at a piece boundary resolves to the piece that ends there.
+        size_t FindPiece(size_t offset, size_t& pieceOffset) const;
+
+        std::string m_Original;
+        std::string m_Add;
+        std::vector<size_t> m_OriginalBreaks;
+        std::vector<size_t> m_AddBreaks;
+
+        std::vector<Piece> m_Pieces;
+        size_t m_Length = 0;
+        size_t m_LineBreaks = 0;
+    };
+
+} // namespace Unicorn::UI
@@ -0,0 +1,197 @@
+#include "text_document.h"
+#include "font_manager.h"
+#include <algorithm>
+
+namespace Unicorn::UI {
+
+    // ============================================================================
+    // LINE LAYOUT
+    // ============================================================================
+
+    size_t LineLayout::HitTest(float x) const {
+        if (byX.empty()) return 0;
+
+        auto it = std::lower_bound(byX.begin(), byX.end(), x,
+            [](const CaretStop& stop, float value) { return stop.x < value; });
+
+        if (it == byX.begin()) return it->offset;
+        if (it == byX.end()) return byX.back().offset;
+
+        auto prev = it - 1;
+        return (x - prev->x) <= (it->x - x) ? prev->offset : it->offset;
+    }
+
+    float LineLayout::CaretX(size_t offset) const {
+        if (byOffset.empty()) return 0.0f;
+
+        auto it = std::upper_bound(byOffset.begin(), byOffset.end(), offset,
+            [](size_t value, const CaretStop& stop) { return value < stop.offset; });
+
+        if (it == byOffset.begin()) return it->x;
+        return (it - 1)->x;
+    }
+
+    static void BuildLineLayout(LineLayout& layout, const std::string& text, FontManager& fonts) {
+        layout.byX.clear();
+        layout.byOffset.clear();
+        layout.width = 0.0f;
+
+        if (text.empty()) {
+            layout.byX.push_back({ 0.0f, 0 });
+            layout.byOffset.push_back({ 0.0f, 0 });
+            return;
+        }
+
+        auto glyphs = fonts.ShapeText(text);
+
+        // Cluster boundaries in logical order: a glyph covers its cluster up
+        // to the next larger cluster (or the end of the line)
+        std::vector<uint32_t> boundaries;
+        boundaries.reserve(glyphs.size() + 1);
+        for (const auto& glyph : glyphs) {
+            boundaries.push_back(glyph.cluster);
+        }
+        boundaries.push_back(static_cast<uint32_t>(text.size()));
+        std::sort(boundaries.begin(), boundaries.end());
+        boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+        layout.byX.reserve(glyphs.size() * 2);
+
+        float x = 0.0f;
+        for (const auto& glyph : glyphs) {
+            uint32_t start = glyph.cluster;
+            uint32_t end = *std::upper_bound(boundaries.begin(), boundaries.end() - 1, start);
+
+            float left = x;
+            float right = x + glyph.advance.x;
+
+            // The caret before a right-to-left cluster sits on its right edge
+            if (glyph.rtl) {
+                layout.byX.push_back({ right, start });
+                layout.byX.push_back({ left, end });
+            }
+            else {
+                layout.byX.push_back({ left, start });
+                layout.byX.push_back({ right, end });
+            }
+
+            x = right;
+        }
+        layout.width = x;
+
+        std::stable_sort(layout.byX.begin(), layout.byX.end(),
+            [](const CaretStop& a, const CaretStop& b) { return a.x < b.x; });
+        layout.byX.erase(std::unique(layout.byX.begin(), layout.byX.end(),
+            [](const CaretStop& a, const CaretStop& b) { return a.x == b.x && a.offset == b.offset; }),
+            layout.byX.end());
+
+        layout.byOffset = layout.byX;
+        std::stable_sort(layout.byOffset.begin(), layout.byOffset.end(),
+            [](const CaretStop& a, const CaretStop& b) { return a.offset < b.offset; });
+        layout.byOffset.erase(std::unique(layout.byOffset.begin(), layout.byOffset.end(),
+            [](const CaretStop& a, const CaretStop& b) { return a.offset == b.offset; }),
+            layout.byOffset.end());
+    }
+
+    // ============================================================================
+    // TEXT DOCUMENT
+    // ============================================================================
+
+    TextDocument::TextDocument() {
+        Reset();
+    }
+
+    TextDocument::TextDocument(std::string text)
+        : m_Text(std::move(text)) {
+        Reset();
+    }
+
+    void TextDocument::SetText(std::string text) {
+        m_Text = PieceTable(std::move(text));
+        Reset();
+        m_Version++;
+    }
+
+    void TextDocument::Reset() {
+        m_Lines.assign(m_Text.LineCount(), LineLayout());
+        m_ShapedLines = 0;
+        m_State = EditorState();
+    }
+
+    void TextDocument::Insert(size_t offset, std::string_view text) {
+        if (text.empty()) return;
+        offset = std::min(offset, m_Text.Length());
+
+        size_t line = m_Text.LineFromOffset(offset);
+        size_t newLines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+
+        m_Text.Insert(offset, text);
+
+        // Only the edited line is reshaped; lines split off from it start empty
+        Invalidate(line);
+        m_Lines.insert(m_Lines.begin() + line + 1, newLines, LineLayout());
+        m_Version++;
+    }
+
+    void TextDocument::Erase(size_t offset, size_t length) {
+        if (offset >= m_Text.Length() || length == 0) return;
+        length = std::min(length, m_Text.Length() - offset);
+
+        size_t firstLine = m_Text.LineFromOffset(offset);
+        size_t lastLine = m_Text.LineFromOffset(offset + length);
+
+        m_Text.Erase(offset, length);
+
+        for (size_t line = firstLine + 1; line <= lastLine; line++) {
+            if (m_Lines[line].valid) m_ShapedLines--;
+        }
+        m_Lines.erase(m_Lines.begin() + firstLine + 1, m_Lines.begin() + lastLine + 1);
+        Invalidate(firstLine);
+        m_Version++;
+    }
+
+    void TextDocument::Invalidate(size_t line) {
+        if (m_Lines[line].valid) {
+            m_Lines[line].valid = false;
+            m_ShapedLines--;
+        }
+    }
+
+    const LineLayout& TextDocument::GetLineLayout(size_t line, FontManager& fonts) {
+        line = std::min(line, m_Lines.size() - 1);
+        LineLayout& layout = m_Lines[line];
+
+        if (!layout.valid || layout.fontGeneration != fonts.GetGeneration()) {
+            if (!layout.valid) m_ShapedLines++;
+
+            BuildLineLayout(layout, m_Text.GetLine(line), fonts);
+            layout.fontGeneration = fonts.GetGeneration();
+            layout.valid = true;
+        }
+
+        return layout;
+    }
+
+    void TextDocument::TrimLayouts(size_t firstLine, size_t lastLine) {
+        if (m_ShapedLines <= s_MaxShapedLines) return;
+
+        for (size_t line = 0; line < m_Lines.size(); line++) {
+            if (line >= firstLine && line <= lastLine) continue;
+
+            LineLayout& layout = m_Lines[line];
+            if (layout.valid) {
+                layout = LineLayout();
+                m_ShapedLines--;
+            }
+        }
+    }
+
+    size_t TextDocument::SelectionStart() const {
+        return std::min(m_State.cursor, m_State.anchor);
+    }
+
+    size_t TextDocument::SelectionEnd() const {
+        return std::max(m_State.cursor, m_State.anchor);
+    }
+
+} // namespace Unicorn::UI
@@ -0,0 +1,88 @@
+#pragma once
+#include "piece_table.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Unicorn::UI {
+
+    class FontManager;
+
+    // A caret position on a shaped line: visual x and the byte offset
+    // (relative to the line start) the caret represents there
+    struct CaretStop {
+        float x = 0.0f;
+        uint32_t offset = 0;
+    };
+
+    // Shaped geometry of one line. Both views hold the same stops: sorted by
+    // x for hit-testing and by offset for drawing the caret and selection,
+    // so either lookup is a binary search.
+    struct LineLayout {
+        std::vector<CaretStop> byX;
+        std::vector<CaretStop> byOffset;
+        float width = 0.0f;
+        uint32_t fontGeneration = 0;
+        bool valid = false;
+
+        size_t HitTest(float x) const;
+        float CaretX(size_t offset) const;
+    };
+
+    // Multi-line text backed by a PieceTable with a per-line layout cache.
+    // An edit only invalidates the lines it touches; lines are shaped lazily
+    // when they are first drawn or hit-tested.
+    class TextDocument {
+    public:
+        struct EditorState {
+            size_t cursor = 0;
+            size_t anchor = 0;          // Selection is [anchor, cursor] in either order
+            float scrollY = 0.0f;
+            float preferredX = -1.0f;   // Sticky column for up/down, -1 when unset
+            bool dragging = false;
+        };
+
+        TextDocument();
+        explicit TextDocument(std::string text);
+
+        void SetText(std::string text);
+        std::string GetText() const { return m_Text.ToString(); }
+        const PieceTable& GetPieceTable() const { return m_Text; }
+
+        void Insert(size_t offset, std::string_view text);
+        void Erase(size_t offset, size_t length);
+
+        size_t Length() const { return m_Text.Length(); }
+        size_t LineCount() const { return m_Text.LineCount(); }
+
+        // Bumped on every edit so callers can cheaply detect changes
+        uint64_t GetVersion() const { return m_Version; }
+
+        const LineLayout& GetLineLayout(size_t line, FontManager& fonts);
+
+        // Drop cached layouts outside [firstLine, lastLine] once too many
+        // lines are shaped (e.g. after scrolling through a large paste)
+        void TrimLayouts(size_t firstLine, size_t lastLine);
+
+        EditorState& GetEditorState() { return m_State; }
+        const EditorState& GetEditorState() const { return m_State; }
+
+        bool HasSelection() const { return m_State.cursor != m_State.anchor; }
+        size_t SelectionStart() const;
+        size_t SelectionEnd() const;
+
+    private:
+        void Reset();
+        void Invalidate(size_t line);
+
+        PieceTable m_Text;
+        std::vector<LineLayout> m_Lines;
+        size_t m_ShapedLines = 0;
+        uint64_t m_Version = 0;
+        EditorState m_State;
+
+        static constexpr size_t s_MaxShapedLines = 2048;
+    };
+
+} // namespace Unicorn::UI
@@ -421,6 +421,8 @@ namespace Unicorn::UI {
                 glyph.offset.y = glyphPos[i].y_offset / 64.0f;
                 glyph.advance.x = glyphPos[i].x_advance / 64.0f;
                 glyph.advance.y = glyphPos[i].y_advance / 64.0f;
+                glyph.cluster = static_cast<uint32_t>(segment.start + glyphInfo[i].cluster);
+                glyph.rtl = segmentIsRTL;
 
                 allGlyphs.push_back(glyph);
                 currentX += glyph.advance.x;
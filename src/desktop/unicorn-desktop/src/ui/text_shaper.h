@@ -18,6 +18,8 @@ namespace Unicorn::UI {
         uint32_t codepoint;     // Unicode codepoint
         glm::vec2 offset;       // X/Y offset
         glm::vec2 advance;      // X/Y advance
+        uint32_t cluster = 0;   // Byte offset of the source text this glyph belongs to
+        bool rtl = false;       // Glyph comes from a right-to-left run
     };
 
     class TextShaper {
@@ -1,23 +1,108 @@
 #include "ui_animation.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 
 namespace Unicorn::UI {
 
-    void AnimationController::Update(float dt) {
-        // Update all button animations
-        for (auto& [id, state] : m_ButtonStates) {
-            // Smooth decay animations
-            if (state.hoverProgress > 0.0f) {
-                state.hoverProgress = std::max(0.0f, state.hoverProgress - dt * m_AnimSpeed);
-            }
-            if (state.activeProgress > 0.0f) {
-                state.activeProgress = std::max(0.0f, state.activeProgress - dt * m_AnimSpeed);
-            }
+    float Tween::Evaluate(double time) const {
+        if (duration <= 0.0 || time >= EndTime()) {
+            return to;
         }
+
+        float t = static_cast<float>((time - startTime) / duration);
+        t = std::min(1.0f, std::max(0.0f, t));
+
+        switch (easing) {
+        case Easing::SmoothStep:
+            t = t * t * (3.0f - 2.0f * t);
+            break;
+        case Easing::EaseOutCubic: {
+            float inv = 1.0f - t;
+            t = 1.0f - inv * inv * inv;
+            break;
+        }
+        case Easing::Linear:
+        default:
+            break;
+        }
+
+        return from + (to - from) * t;
+    }
+
+    double AnimationController::Now() {
+        using Clock = std::chrono::steady_clock;
+        static const Clock::time_point s_Epoch = Clock::now();
+        return std::chrono::duration<double>(Clock::now() - s_Epoch).count();
     }
 
-    AnimationController::ButtonState& AnimationController::GetButtonState(const std::string& id) {
-        return m_ButtonStates[id];
+    bool AnimationController::Update(double time) {
+        // A tween that ended since the last frame still needs one more
+        // redraw so its final value lands on screen
+        bool wasAnimating = HasActiveAnimations();
+
+        m_FrameTime = time;
+
+        bool wokeUp = false;
+        if (m_NextWakeup <= time) {
+            m_NextWakeup = NoDeadline;
+            wokeUp = true;
+        }
+
+        return wasAnimating || wokeUp || HasActiveAnimations();
+    }
+
+    double AnimationController::GetNextDeadline() const {
+        if (HasActiveAnimations()) {
+            return m_FrameTime;
+        }
+        return m_NextWakeup;
+    }
+
+    void AnimationController::ScheduleWakeup(double time) {
+        m_NextWakeup = std::min(m_NextWakeup, time);
+    }
+
+    void AnimationController::EndFrame() {
+        // Immediate mode: a widget that still exists animated this frame
+        std::erase_if(m_Tweens, [this](const auto& entry) { return entry.second.lastFrame != m_Frame; });
+        std::erase_if(m_Buttons, [this](const auto& entry) { return entry.second.lastFrame != m_Frame; });
+        m_Frame++;
+    }
+
+    float AnimationController::Retarget(Tween& tween, float target, float duration, Easing easing) {
+        if (tween.to != target) {
+            float current = tween.Evaluate(m_FrameTime);
+
+            tween.from = current;
+            tween.to = target;
+            tween.startTime = m_FrameTime;
+            tween.duration = duration * std::fabs(target - current);
+            tween.easing = easing;
+
+            m_LatestEndTime = std::max(m_LatestEndTime, tween.EndTime());
+        }
+
+        return tween.Evaluate(m_FrameTime);
+    }
+
+    float AnimationController::Animate(std::string_view id, float target, float duration, Easing easing) {
+        TrackedTween& entry = m_Tweens[std::hash<std::string_view>()(id)];
+        entry.lastFrame = m_Frame;
+        return Retarget(entry.tween, target, duration, easing);
+    }
+
+    AnimationController::ButtonState AnimationController::UpdateButtonState(std::string_view id,
+        bool hovered, bool active) {
+        ButtonTweens& button = m_Buttons[std::hash<std::string_view>()(id)];
+        button.lastFrame = m_Frame;
+
+        ButtonState state;
+        state.hoverProgress = Retarget(button.hover, hovered ? 1.0f : 0.0f,
+            m_ButtonTransitionTime, Easing::SmoothStep);
+        state.activeProgress = Retarget(button.active, active ? 1.0f : 0.0f,
+            m_ButtonTransitionTime, Easing::SmoothStep);
+        return state;
     }
 
     float AnimationController::Lerp(float a, float b, float t) {
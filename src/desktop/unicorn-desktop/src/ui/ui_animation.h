@@ -2,41 +2,105 @@
 #include <glm/glm.hpp>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <limits>
+#include <cstdint>
 
 namespace Unicorn::UI {
 
+    enum class Easing {
+        Linear,
+        SmoothStep,
+        EaseOutCubic
+    };
+
+    // A single value moving from 'from' to 'to' over a fixed time window.
+    // Because the end time is known up front, the scheduler can tell the
+    // main loop exactly how long it may sleep.
+    struct Tween {
+        float from = 0.0f;
+        float to = 0.0f;
+        double startTime = 0.0;
+        double duration = 0.0;
+        Easing easing = Easing::Linear;
+
+        double EndTime() const { return startTime + duration; }
+        bool IsFinished(double time) const { return time >= EndTime(); }
+        float Evaluate(double time) const;
+    };
+
     class AnimationController {
     public:
+        static constexpr double NoDeadline = std::numeric_limits<double>::infinity();
+
         struct ButtonState {
-            float hoverProgress = 0.0f;    // 0 to 1
-            float activeProgress = 0.0f;   // 0 to 1
-            float scale = 1.0f;
-            glm::vec4 color;
+            float hoverProgress = 0.0f;    // 0 to 1 (eased)
+            float activeProgress = 0.0f;   // 0 to 1 (eased)
         };
 
-        bool HasActiveAnimations() const {
-            for (const auto& [id, state] : m_ButtonStates) {
-                if (state.hoverProgress > 0.01f ||
-                    state.hoverProgress < 0.99f ||
-                    state.activeProgress > 0.01f) {
-                    return true;
-                }
-            }
-            return false;
-        }
+        // Monotonic clock (seconds) shared by all tweens and deadlines
+        static double Now();
+
+        // Advance the frame clock; call once per frame before widgets animate.
+        // Returns true while something still needs a redraw this frame.
+        bool Update(double time);
+
+        // Is any tween still in flight at the current frame time?
+        bool HasActiveAnimations() const { return m_FrameTime < m_LatestEndTime; }
+
+        // Earliest time the UI must be redrawn: the current frame time while a
+        // tween is running, the nearest scheduled wakeup otherwise, or NoDeadline
+        double GetNextDeadline() const;
+
+        // Request a redraw at an absolute time (e.g. caret blink). Only the
+        // earliest wakeup is kept: every redraw re-runs the widgets, which
+        // schedule their next wakeup again if they still need one.
+        void ScheduleWakeup(double time);
 
-        void Update(float dt);
+        // Call once per frame after the widgets ran: drops the tweens of
+        // widgets that were not drawn this frame
+        void EndFrame();
 
-        // Get/Set button state
-        ButtonState& GetButtonState(const std::string& id);
+        // Retarget the tween 'id' toward 'target'. 'duration' is the time for a
+        // full 0 -> 1 transition; partial moves are scaled by distance so the
+        // speed stays constant when the target flips mid-flight.
+        float Animate(std::string_view id, float target, float duration,
+            Easing easing = Easing::Linear);
+
+        // Hover/press progress for a button; both tweens live under the
+        // button's id, so no per-frame id strings are built
+        ButtonState UpdateButtonState(std::string_view id, bool hovered, bool active);
+
+        double GetFrameTime() const { return m_FrameTime; }
 
         // Smooth interpolation
         static float Lerp(float a, float b, float t);
         static glm::vec4 LerpColor(const glm::vec4& a, const glm::vec4& b, float t);
 
     private:
-        std::unordered_map<std::string, ButtonState> m_ButtonStates;
-        const float m_AnimSpeed = 8.0f; // Animation speed
+        struct TrackedTween {
+            Tween tween;
+            uint64_t lastFrame = 0;
+        };
+
+        struct ButtonTweens {
+            Tween hover;
+            Tween active;
+            uint64_t lastFrame = 0;
+        };
+
+        float Retarget(Tween& tween, float target, float duration, Easing easing);
+
+        // Keyed by the hash of the widget id
+        std::unordered_map<size_t, TrackedTween> m_Tweens;
+        std::unordered_map<size_t, ButtonTweens> m_Buttons;
+        uint64_t m_Frame = 0;
+
+        double m_FrameTime = 0.0;
+        double m_NextWakeup = NoDeadline;
+        double m_LatestEndTime = 0.0;
+
+        const float m_ButtonTransitionTime = 1.0f / 16.0f; // 62.5 ms full transition
     };
 
 } // namespace Unicorn::UI
\ No newline at end of file
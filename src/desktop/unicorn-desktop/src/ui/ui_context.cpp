@@ -8,6 +8,7 @@
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
 
 namespace Unicorn::UI {
 
@@ -61,8 +62,17 @@ namespace Unicorn::UI {
     void UIContext::BeginFrame() {
         m_DrawCommands.clear();
         m_IDStack.clear();
+        m_OpenStacks.clear();
+        m_NextItemFlex = FlexItem();
         m_LastWidgetState = WidgetState();
 
+        m_LayoutCache.BeginFrame(m_Renderer ? m_Renderer->GetFontManager().GetGeneration() : 0);
+
+        // Icons rasterized in the background since the last frame
+        if (m_IconManager) {
+            m_IconManager->ProcessUploads();
+        }
+
         m_LastMousePos = m_MousePos;
         m_MousePos = Input::GetMousePosition();
         m_MouseButtons[0] = Input::IsMouseButtonPressed(GLFW_MOUSE_BUTTON_LEFT);
@@ -75,7 +85,7 @@ namespace Unicorn::UI {
         m_DeltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
 
-        UpdatePhysicsScroll(m_DeltaTime);
+        UpdatePhysicsScroll(GetScrollTime());
 
         m_FrameCount++;
 
@@ -85,6 +95,10 @@ namespace Unicorn::UI {
     }
 
     void UIContext::EndFrame() {
+        if (m_AnimController) {
+            m_AnimController->EndFrame();
+        }
+
         // Clear active state if mouse released
         if (!m_MouseButtons[0]) {
             m_ActiveID.clear();
@@ -144,7 +158,7 @@ namespace Unicorn::UI {
 
         glm::vec2 finalPos = pos;
         if (m_GlobalScroll.active) {
-            finalPos.y += m_GlobalScroll.physics.offset.y;
+            finalPos.y += m_GlobalScroll.physics->offset.y;
         }
 
         m_LayoutStack.clear();
@@ -221,6 +235,7 @@ namespace Unicorn::UI {
     void UIContext::BeginHorizontal() {
         LayoutContext layout = m_LayoutStack.back();
         layout.direction = LayoutContext::Direction::Horizontal;
+        layout.stack = -1;
         m_LayoutStack.push_back(layout);
     }
 
@@ -267,13 +282,150 @@ namespace Unicorn::UI {
         layout.cursor.y += 30.0f;
     }
 
+    // ============================================================================
+    // STACK LAYOUT
+    // ============================================================================
+
+    void UIContext::BeginStack(const std::string& id, StackAxis axis,
+        const glm::vec2& size, const StackStyle& style) {
+        LayoutCache::StackRecord& record = m_LayoutCache.GetStack(GenerateID(id));
+
+        bool rtl = m_LayoutDirection == LayoutDirection::RTL;
+        if (style.direction != LayoutDirection::Auto) {
+            rtl = style.direction == LayoutDirection::RTL;
+        }
+        else if (m_LayoutStack.back().stack >= 0) {
+            rtl = m_OpenStacks[m_LayoutStack.back().stack].record->rtl;
+        }
+
+        // The stack is itself an item of its parent: it asks for its natural
+        // size from last frame and takes whatever slot the parent arranges
+        bool nested = m_LayoutStack.back().stack >= 0;
+        glm::vec2 slot(
+            size.x > 0.0f ? size.x : record.naturalSize.x,
+            size.y > 0.0f ? size.y : record.naturalSize.y);
+        glm::vec2 origin = PlaceItem(slot);
+
+        glm::vec2 available(
+            (size.x > 0.0f || nested) ? slot.x : 0.0f,
+            (size.y > 0.0f || nested) ? slot.y : 0.0f);
+        m_LayoutCache.Arrange(record, axis, style, rtl, available);
+
+        OpenStack open;
+        open.record = &record;
+        open.origin = origin;
+        m_OpenStacks.push_back(std::move(open));
+
+        LayoutContext layout;
+        layout.cursor = origin + glm::vec2(style.padding);
+        layout.spacing = style.spacing;
+        layout.padding = style.padding;
+        layout.direction = axis == StackAxis::Horizontal
+            ? LayoutContext::Direction::Horizontal : LayoutContext::Direction::Vertical;
+        layout.stack = static_cast<int>(m_OpenStacks.size()) - 1;
+        m_LayoutStack.push_back(layout);
+    }
+
+    void UIContext::EndStack() {
+        if (m_OpenStacks.empty() || m_LayoutStack.size() < 2 || m_LayoutStack.back().stack < 0) {
+            return;
+        }
+
+        OpenStack open = std::move(m_OpenStacks.back());
+        m_OpenStacks.pop_back();
+        m_LayoutStack.pop_back();
+
+        LayoutCache::StackRecord& record = *open.record;
+        glm::vec2 previousNaturalSize = record.naturalSize;
+        if (open.measured != record.items) {
+            record.items = std::move(open.measured);
+            record.dirty = true;
+        }
+
+        if (m_LayoutCache.Arrange(record, record.axis, record.style, record.rtl, record.available)) {
+            // Children were drawn at the previous arrangement. Moving their draw
+            // commands fixes positions in this frame; a child whose size changed
+            // has to be rebuilt, which costs one more frame.
+            bool resized = false;
+            for (size_t i = 0; i < open.placed.size() && i < record.arranged.size(); i++) {
+                const ArrangedItem& target = record.arranged[i];
+                glm::vec2 delta = target.pos - open.placed[i].pos;
+
+                size_t begin = open.firstCommand[i];
+                size_t end = i + 1 < open.firstCommand.size() ? open.firstCommand[i + 1] : m_DrawCommands.size();
+                if (delta != glm::vec2(0.0f)) {
+                    for (size_t c = begin; c < end; c++) {
+                        m_DrawCommands[c].pos += delta;
+                    }
+                }
+
+                if (target.size != open.placed[i].size) {
+                    resized = true;
+                }
+            }
+
+            // A new natural size also moves this stack within its parent
+            if (resized || record.naturalSize != previousNaturalSize) {
+                RequestFrame(FrameSource::Input);
+            }
+        }
+
+        glm::vec2 outer(
+            record.available.x > 0.0f ? record.available.x : record.size.x,
+            record.available.y > 0.0f ? record.available.y : record.size.y);
+        m_LayoutStack.back().Advance(outer);
+    }
+
+    void UIContext::SetNextItemFlex(float grow, float shrink) {
+        m_NextItemFlex.grow = grow;
+        m_NextItemFlex.shrink = shrink;
+    }
+
+    glm::vec2 UIContext::PlaceItem(glm::vec2& size) {
+        auto& layout = m_LayoutStack.back();
+
+        FlexItem item = m_NextItemFlex;
+        m_NextItemFlex = FlexItem();
+
+        if (layout.stack < 0) {
+            return layout.cursor;
+        }
+
+        OpenStack& open = m_OpenStacks[layout.stack];
+        size_t index = open.measured.size();
+
+        item.basis = size;
+        open.measured.push_back(item);
+        open.firstCommand.push_back(m_DrawCommands.size());
+
+        // New children (first frame, or appended since) fall back to the
+        // running cursor until EndStack arranges them
+        const auto& arranged = open.record->arranged;
+        if (index < arranged.size()) {
+            layout.cursor = open.origin + arranged[index].pos;
+            size = arranged[index].size;
+        }
+
+        ArrangedItem placed;
+        placed.pos = layout.cursor - open.origin;
+        placed.size = size;
+        open.placed.push_back(placed);
+
+        return layout.cursor;
+    }
+
+    bool UIContext::IsLayoutRTL() const {
+        int stack = m_LayoutStack.empty() ? -1 : m_LayoutStack.back().stack;
+        return stack >= 0 && m_OpenStacks[stack].record->rtl;
+    }
+
     bool UIContext::Button(const std::string& label, const glm::vec2& size) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 buttonSize = size;
         if (buttonSize.x == 0) buttonSize.x = 120;
         if (buttonSize.y == 0) buttonSize.y = 30;
 
-        glm::vec2 pos = layout.cursor;
+        glm::vec2 pos = PlaceItem(buttonSize);
         std::string id = GenerateID(label);
 
         WidgetState state = ProcessWidget(pos, buttonSize);
@@ -294,7 +446,7 @@ namespace Unicorn::UI {
         AddDrawCommand(bgCmd);
 
         // Draw button text
-        glm::vec2 textSize = CalcTextSize(label);
+        glm::vec2 textSize = MeasureText(id, label);
         glm::vec2 textPos = pos + (buttonSize - textSize) * 0.5f;
 
         DrawCommand textCmd;
@@ -316,10 +468,15 @@ namespace Unicorn::UI {
     void UIContext::TextColored(const glm::vec4& color, const std::string& text) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 textSize = CalcTextSize(text);
+        glm::vec2 slot = textSize;
+        glm::vec2 pos = PlaceItem(slot);
+        if (IsLayoutRTL()) {
+            pos.x += slot.x - textSize.x;
+        }
 
         DrawCommand cmd;
         cmd.type = DrawCommand::Type::Text;
-        cmd.pos = layout.cursor;
+        cmd.pos = pos;
         cmd.color = color;
         cmd.text = text;
         cmd.textDirection = 0; // Auto
@@ -331,10 +488,15 @@ namespace Unicorn::UI {
     void UIContext::TextLTR(const std::string& text) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 textSize = CalcTextSize(text);
+        glm::vec2 slot = textSize;
+        glm::vec2 pos = PlaceItem(slot);
+        if (IsLayoutRTL()) {
+            pos.x += slot.x - textSize.x;
+        }
 
         DrawCommand cmd;
         cmd.type = DrawCommand::Type::Text;
-        cmd.pos = layout.cursor;
+        cmd.pos = pos;
         cmd.color = Unicorn::UI::Color::Text;
         cmd.text = text;
         cmd.textDirection = 1; // LTR
@@ -346,10 +508,15 @@ namespace Unicorn::UI {
     void UIContext::TextRTL(const std::string& text) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 textSize = CalcTextSize(text);
+        glm::vec2 slot = textSize;
+        glm::vec2 pos = PlaceItem(slot);
+        if (IsLayoutRTL()) {
+            pos.x += slot.x - textSize.x;
+        }
 
         DrawCommand cmd;
         cmd.type = DrawCommand::Type::Text;
-        cmd.pos = layout.cursor;
+        cmd.pos = pos;
         cmd.color = Unicorn::UI::Color::Text;
         cmd.text = text;
         cmd.textDirection = 2; // RTL
@@ -361,9 +528,21 @@ namespace Unicorn::UI {
     bool UIContext::Checkbox(const std::string& label, bool* value) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 boxSize(20, 20);
-        glm::vec2 pos = layout.cursor;
 
         std::string id = GenerateID(label);
+        glm::vec2 textSize = MeasureText(id, label);
+        glm::vec2 totalSize(boxSize.x + 25 + textSize.x, boxSize.y);
+        glm::vec2 itemSize = totalSize;
+        glm::vec2 pos = PlaceItem(itemSize);
+
+        // Box on the leading edge: right side in RTL stacks
+        bool rtl = IsLayoutRTL();
+        glm::vec2 labelPos = pos + glm::vec2(25, 2);
+        if (rtl) {
+            pos.x += itemSize.x - boxSize.x;
+            labelPos.x = pos.x - 5 - textSize.x;
+        }
+
         WidgetState state = ProcessWidget(pos, boxSize);
         m_LastWidgetState = state;
 
@@ -390,13 +569,12 @@ namespace Unicorn::UI {
 
         DrawCommand textCmd;
         textCmd.type = DrawCommand::Type::Text;
-        textCmd.pos = pos + glm::vec2(25, 2);
+        textCmd.pos = labelPos;
         textCmd.color = Unicorn::UI::Color::Text;
         textCmd.text = label;
         AddDrawCommand(textCmd);
 
-        glm::vec2 totalSize(boxSize.x + 25 + CalcTextSize(label).x, boxSize.y);
-        layout.Advance(totalSize);
+        layout.Advance(itemSize);
 
         return state.clicked;
     }
@@ -418,8 +596,8 @@ namespace Unicorn::UI {
         // Show label if not hidden
         if (!label.empty() && label[0] != '#') {
             Text(label);
-            pos = layout.cursor;
         }
+        pos = PlaceItem(inputSize);
 
         std::string id = GenerateID(label);
         WidgetState state = ProcessWidget(pos, inputSize);
@@ -988,7 +1166,11 @@ namespace Unicorn::UI {
                 AddDrawCommand(cursorCmd);
             }
 
-            m_IsDirty = true;
+            // Wake up exactly when the caret toggles instead of redrawing every frame
+            if (m_AnimController) {
+                double untilToggle = (530 - elapsed.count() % 530) / 1000.0;
+                m_AnimController->ScheduleWakeup(m_AnimController->GetFrameTime() + untilToggle);
+            }
         }
 
         DrawCommand scissorCmd;
@@ -1041,6 +1223,408 @@ namespace Unicorn::UI {
         return text.length();
     }
 
+    // ============================================================================
+    // MULTI-LINE TEXT EDITOR
+    // ============================================================================
+
+    static std::string EncodeUTF8(uint32_t codepoint) {
+        std::string utf8;
+        if (codepoint < 0x80) {
+            utf8 += static_cast<char>(codepoint);
+        }
+        else if (codepoint < 0x800) {
+            utf8 += static_cast<char>(0xC0 | (codepoint >> 6));
+            utf8 += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if (codepoint < 0x10000) {
+            utf8 += static_cast<char>(0xE0 | (codepoint >> 12));
+            utf8 += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            utf8 += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else {
+            utf8 += static_cast<char>(0xF0 | (codepoint >> 18));
+            utf8 += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            utf8 += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            utf8 += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        return utf8;
+    }
+
+    bool UIContext::TextEditor(const std::string& label, TextDocument& document, const glm::vec2& size) {
+        if (!label.empty() && label[0] != '#') {
+            Text(label);
+        }
+
+        glm::vec2 editorSize = size;
+        glm::vec2 pos = PlaceItem(editorSize);
+        auto& layout = m_LayoutStack.back();
+
+        std::string id = GenerateID(label);
+        WidgetState state = ProcessWidget(pos, editorSize);
+        m_LastWidgetState = state;
+
+        if (!m_Renderer) {
+            layout.Advance(editorSize);
+            return false;
+        }
+
+        auto& fonts = m_Renderer->GetFontManager();
+        auto& editor = document.GetEditorState();
+        const PieceTable& text = document.GetPieceTable();
+        uint64_t versionBefore = document.GetVersion();
+
+        const float borderWidth = 2.0f;
+        const float padding = 8.0f;
+        const float lineHeight = 20.0f;
+        glm::vec2 contentPos = pos + glm::vec2(padding, padding);
+        float visibleHeight = editorSize.y - padding * 2.0f;
+        size_t visibleLines = static_cast<size_t>(glm::max(1.0f, visibleHeight / lineHeight));
+
+        bool isActive = (m_ActiveEditorID == id);
+        bool caretMoved = false;
+
+        // Line under a y coordinate, then a binary search over that line's
+        // cached caret stops; nothing is reshaped unless the line was edited
+        auto OffsetAt = [&](const glm::vec2& point) -> size_t {
+            float row = (point.y - contentPos.y + editor.scrollY) / lineHeight;
+            size_t line = static_cast<size_t>(glm::clamp(row, 0.0f,
+                static_cast<float>(document.LineCount() - 1)));
+            const LineLayout& lineLayout = document.GetLineLayout(line, fonts);
+            return text.LineStart(line) + lineLayout.HitTest(point.x - contentPos.x);
+        };
+
+        // === MOUSE ===
+        if (m_MouseButtons[0] && !state.hovered && isActive && !editor.dragging) {
+            m_ActiveEditorID.clear();
+            isActive = false;
+            m_IsDirty = true;
+        }
+
+        bool shift = Input::IsKeyPressed(GLFW_KEY_LEFT_SHIFT) ||
+            Input::IsKeyPressed(GLFW_KEY_RIGHT_SHIFT);
+        bool ctrl = Input::IsKeyPressed(GLFW_KEY_LEFT_CONTROL) ||
+            Input::IsKeyPressed(GLFW_KEY_RIGHT_CONTROL);
+
+        if (m_MouseButtons[0]) {
+            if (state.hovered && !editor.dragging) {
+                m_ActiveEditorID = id;
+                isActive = true;
+
+                editor.cursor = OffsetAt(m_MousePos);
+                if (!shift) editor.anchor = editor.cursor;
+                editor.preferredX = -1.0f;
+                editor.dragging = true;
+                m_IsDirty = true;
+            }
+            else if (editor.dragging && isActive) {
+                // Keep selecting past the edges by scrolling along
+                if (m_MousePos.y < contentPos.y) editor.scrollY -= lineHeight;
+                else if (m_MousePos.y > contentPos.y + visibleHeight) editor.scrollY += lineHeight;
+
+                size_t offset = OffsetAt(m_MousePos);
+                if (offset != editor.cursor) {
+                    editor.cursor = offset;
+                    m_IsDirty = true;
+                }
+            }
+        }
+        else if (editor.dragging) {
+            editor.dragging = false;
+            m_IsDirty = true;
+        }
+
+        if (state.hovered && m_MouseWheelDelta != 0.0f) {
+            editor.scrollY -= m_MouseWheelDelta * lineHeight * 3.0f;
+            m_MouseWheelDelta = 0.0f; // Don't scroll the page as well
+            m_IsDirty = true;
+        }
+
+        // === KEYBOARD ===
+        if (isActive) {
+            auto PrevChar = [&](size_t offset) -> size_t {
+                if (offset == 0) return 0;
+                do { offset--; } while (offset > 0 && (text.At(offset) & 0xC0) == 0x80);
+                return offset;
+            };
+            auto NextChar = [&](size_t offset) -> size_t {
+                size_t length = text.Length();
+                if (offset >= length) return length;
+                do { offset++; } while (offset < length && (text.At(offset) & 0xC0) == 0x80);
+                return offset;
+            };
+            auto IsSpace = [&](size_t offset) {
+                char c = text.At(offset);
+                return c == ' ' || c == '\t' || c == '\n';
+            };
+            auto PrevWord = [&](size_t offset) -> size_t {
+                while (offset > 0 && IsSpace(offset - 1)) offset = PrevChar(offset);
+                while (offset > 0 && !IsSpace(offset - 1)) offset = PrevChar(offset);
+                return offset;
+            };
+            auto NextWord = [&](size_t offset) -> size_t {
+                size_t length = text.Length();
+                while (offset < length && !IsSpace(offset)) offset = NextChar(offset);
+                while (offset < length && IsSpace(offset)) offset = NextChar(offset);
+                return offset;
+            };
+
+            auto MoveTo = [&](size_t offset, bool extend) {
+                editor.cursor = offset;
+                if (!extend) editor.anchor = offset;
+                caretMoved = true;
+                m_IsDirty = true;
+            };
+            auto MoveVertical = [&](long delta) {
+                size_t line = text.LineFromOffset(editor.cursor);
+                if (editor.preferredX < 0.0f) {
+                    const LineLayout& current = document.GetLineLayout(line, fonts);
+                    editor.preferredX = current.CaretX(editor.cursor - text.LineStart(line));
+                }
+
+                long target = glm::clamp(static_cast<long>(line) + delta, 0L,
+                    static_cast<long>(document.LineCount()) - 1);
+                const LineLayout& targetLayout = document.GetLineLayout(target, fonts);
+                float preferredX = editor.preferredX;
+                MoveTo(text.LineStart(target) + targetLayout.HitTest(preferredX), shift);
+                editor.preferredX = preferredX;
+            };
+            auto DeleteSelection = [&]() -> bool {
+                if (!document.HasSelection()) return false;
+                size_t start = document.SelectionStart();
+                document.Erase(start, document.SelectionEnd() - start);
+                MoveTo(start, false);
+                return true;
+            };
+            auto InsertText = [&](std::string_view insert) {
+                DeleteSelection();
+                document.Insert(editor.cursor, insert);
+                MoveTo(editor.cursor + insert.size(), false);
+            };
+
+            if (IsKeyPressedWithRepeat(GLFW_KEY_LEFT)) {
+                if (document.HasSelection() && !shift) MoveTo(document.SelectionStart(), false);
+                else MoveTo(ctrl ? PrevWord(editor.cursor) : PrevChar(editor.cursor), shift);
+                editor.preferredX = -1.0f;
+            }
+            if (IsKeyPressedWithRepeat(GLFW_KEY_RIGHT)) {
+                if (document.HasSelection() && !shift) MoveTo(document.SelectionEnd(), false);
+                else MoveTo(ctrl ? NextWord(editor.cursor) : NextChar(editor.cursor), shift);
+                editor.preferredX = -1.0f;
+            }
+            if (IsKeyPressedWithRepeat(GLFW_KEY_UP)) MoveVertical(-1);
+            if (IsKeyPressedWithRepeat(GLFW_KEY_DOWN)) MoveVertical(1);
+            if (IsKeyPressedWithRepeat(GLFW_KEY_PAGE_UP)) MoveVertical(-static_cast<long>(visibleLines));
+            if (IsKeyPressedWithRepeat(GLFW_KEY_PAGE_DOWN)) MoveVertical(static_cast<long>(visibleLines));
+
+            if (IsKeyPressedWithRepeat(GLFW_KEY_HOME)) {
+                size_t line = text.LineFromOffset(editor.cursor);
+                MoveTo(ctrl ? 0 : text.LineStart(line), shift);
+                editor.preferredX = -1.0f;
+            }
+            if (IsKeyPressedWithRepeat(GLFW_KEY_END)) {
+                size_t line = text.LineFromOffset(editor.cursor);
+                MoveTo(ctrl ? text.Length() : text.LineStart(line) + text.LineLength(line), shift);
+                editor.preferredX = -1.0f;
+            }
+
+            if (IsKeyPressedWithRepeat(GLFW_KEY_BACKSPACE)) {
+                if (!DeleteSelection() && editor.cursor > 0) {
+                    size_t start = ctrl ? PrevWord(editor.cursor) : PrevChar(editor.cursor);
+                    document.Erase(start, editor.cursor - start);
+                    MoveTo(start, false);
+                }
+                editor.preferredX = -1.0f;
+            }
+            if (IsKeyPressedWithRepeat(GLFW_KEY_DELETE)) {
+                if (!DeleteSelection() && editor.cursor < text.Length()) {
+                    size_t end = ctrl ? NextWord(editor.cursor) : NextChar(editor.cursor);
+                    document.Erase(editor.cursor, end - editor.cursor);
+                    m_IsDirty = true;
+                }
+                editor.preferredX = -1.0f;
+            }
+
+            if (IsKeyPressedWithRepeat(GLFW_KEY_ENTER) || IsKeyPressedWithRepeat(GLFW_KEY_KP_ENTER)) {
+                InsertText("\n");
+                editor.preferredX = -1.0f;
+            }
+
+            // === CLIPBOARD ===
+            if (ctrl && IsKeyPressedWithRepeat(GLFW_KEY_A)) {
+                editor.anchor = 0;
+                editor.cursor = text.Length();
+                m_IsDirty = true;
+            }
+            if (ctrl && (IsKeyPressedWithRepeat(GLFW_KEY_C) || IsKeyPressedWithRepeat(GLFW_KEY_X))) {
+                if (document.HasSelection()) {
+                    size_t start = document.SelectionStart();
+                    std::string selected = text.GetText(start, document.SelectionEnd() - start);
+                    glfwSetClipboardString(nullptr, selected.c_str());
+
+                    if (Input::IsKeyPressed(GLFW_KEY_X)) {
+                        DeleteSelection();
+                    }
+                }
+            }
+            if (ctrl && IsKeyPressedWithRepeat(GLFW_KEY_V)) {
+                const char* clipboardText = glfwGetClipboardString(nullptr);
+                if (clipboardText) {
+                    std::string paste(clipboardText);
+                    paste.erase(std::remove(paste.begin(), paste.end(), '\r'), paste.end());
+                    InsertText(paste);
+                }
+                editor.preferredX = -1.0f;
+            }
+
+            // === TEXT INPUT ===
+            unsigned int charInput = Input::GetLastChar();
+            if ((charInput >= 32 && charInput < 127) || charInput >= 0x80) {
+                InsertText(EncodeUTF8(charInput));
+                editor.preferredX = -1.0f;
+            }
+
+            if (Input::IsKeyPressed(GLFW_KEY_ESCAPE)) {
+                m_ActiveEditorID.clear();
+                isActive = false;
+                m_IsDirty = true;
+            }
+        }
+
+        // Keep the caret in view after keyboard navigation
+        size_t cursorLine = text.LineFromOffset(editor.cursor);
+        if (caretMoved) {
+            float caretTop = cursorLine * lineHeight;
+            if (caretTop < editor.scrollY) {
+                editor.scrollY = caretTop;
+            }
+            else if (caretTop + lineHeight > editor.scrollY + visibleHeight) {
+                editor.scrollY = caretTop + lineHeight - visibleHeight;
+            }
+        }
+
+        float contentHeight = document.LineCount() * lineHeight;
+        float maxScroll = glm::max(0.0f, contentHeight - visibleHeight);
+        editor.scrollY = glm::clamp(editor.scrollY, 0.0f, maxScroll);
+
+        // === RENDERING ===
+        DrawCommand borderCmd;
+        borderCmd.type = DrawCommand::Type::RoundedRect;
+        borderCmd.pos = pos;
+        borderCmd.size = editorSize;
+        borderCmd.color = isActive ? Unicorn::UI::Color::Primary
+            : (state.hovered ? glm::vec4(0.5f, 0.5f, 0.5f, 1.0f) : Unicorn::UI::Color::Border);
+        borderCmd.rounding = 6.0f;
+        AddDrawCommand(borderCmd);
+
+        DrawCommand bgCmd;
+        bgCmd.type = DrawCommand::Type::RoundedRect;
+        bgCmd.pos = pos + glm::vec2(borderWidth);
+        bgCmd.size = editorSize - glm::vec2(borderWidth * 2.0f);
+        bgCmd.color = Unicorn::UI::Color::White;
+        bgCmd.rounding = 5.0f;
+        AddDrawCommand(bgCmd);
+
+        DrawCommand scissorCmd;
+        scissorCmd.type = DrawCommand::Type::PushScissor;
+        scissorCmd.pos = pos + glm::vec2(borderWidth);
+        scissorCmd.size = editorSize - glm::vec2(borderWidth * 2.0f);
+        AddDrawCommand(scissorCmd);
+
+        // Only the visible lines are fetched, shaped and drawn
+        size_t firstLine = static_cast<size_t>(editor.scrollY / lineHeight);
+        size_t lastLine = glm::min(document.LineCount() - 1, firstLine + visibleLines + 1);
+
+        size_t rangeStart = text.LineStart(firstLine);
+        size_t rangeEnd = lastLine + 1 < document.LineCount()
+            ? text.LineStart(lastLine + 1) - 1 : text.Length();
+        std::string visibleText = text.GetText(rangeStart, rangeEnd - rangeStart);
+
+        size_t selStart = document.SelectionStart();
+        size_t selEnd = document.SelectionEnd();
+
+        size_t lineOffset = 0;
+        for (size_t line = firstLine; line <= lastLine; line++) {
+            size_t lineEndInRange = visibleText.find('\n', lineOffset);
+            if (lineEndInRange == std::string::npos) lineEndInRange = visibleText.size();
+
+            size_t lineStart = rangeStart + lineOffset;
+            size_t lineEnd = rangeStart + lineEndInRange;
+            float y = contentPos.y + line * lineHeight - editor.scrollY;
+            const LineLayout& lineLayout = document.GetLineLayout(line, fonts);
+
+            if (selStart != selEnd && selStart <= lineEnd && selEnd >= lineStart) {
+                float x0 = lineLayout.CaretX(glm::max(selStart, lineStart) - lineStart);
+                float x1 = lineLayout.CaretX(glm::min(selEnd, lineEnd) - lineStart);
+                if (selEnd > lineEnd) x1 = glm::max(x1, lineLayout.width) + 6.0f; // Selected newline
+
+                DrawCommand selectionCmd;
+                selectionCmd.type = DrawCommand::Type::Rect;
+                selectionCmd.pos = glm::vec2(contentPos.x + glm::min(x0, x1), y);
+                selectionCmd.size = glm::vec2(glm::abs(x1 - x0), lineHeight);
+                selectionCmd.color = glm::vec4(0.4f, 0.6f, 1.0f, 0.3f);
+                AddDrawCommand(selectionCmd);
+            }
+
+            if (lineEndInRange > lineOffset) {
+                DrawCommand textCmd;
+                textCmd.type = DrawCommand::Type::Text;
+                textCmd.pos = glm::vec2(contentPos.x, y + 2.0f);
+                textCmd.color = Unicorn::UI::Color::Text;
+                textCmd.text = visibleText.substr(lineOffset, lineEndInRange - lineOffset);
+                AddDrawCommand(textCmd);
+            }
+
+            lineOffset = lineEndInRange + 1;
+        }
+
+        if (isActive) {
+            static auto lastBlink = std::chrono::high_resolution_clock::now();
+            auto now = std::chrono::high_resolution_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastBlink);
+
+            bool showCursor = (elapsed.count() / 530) % 2 == 0;
+            if (showCursor && cursorLine >= firstLine && cursorLine <= lastLine) {
+                const LineLayout& lineLayout = document.GetLineLayout(cursorLine, fonts);
+                float caretX = lineLayout.CaretX(editor.cursor - text.LineStart(cursorLine));
+
+                DrawCommand cursorCmd;
+                cursorCmd.type = DrawCommand::Type::Rect;
+                cursorCmd.pos = glm::vec2(contentPos.x + caretX, contentPos.y + cursorLine * lineHeight - editor.scrollY + 1.0f);
+                cursorCmd.size = glm::vec2(2, lineHeight - 2.0f);
+                cursorCmd.color = Unicorn::UI::Color::Primary;
+                AddDrawCommand(cursorCmd);
+            }
+
+            if (m_AnimController) {
+                double untilToggle = (530 - elapsed.count() % 530) / 1000.0;
+                m_AnimController->ScheduleWakeup(m_AnimController->GetFrameTime() + untilToggle);
+            }
+        }
+
+        if (contentHeight > visibleHeight) {
+            float trackHeight = editorSize.y - borderWidth * 2.0f;
+            float thumbHeight = glm::max(20.0f, trackHeight * (visibleHeight / contentHeight));
+            float thumbY = (maxScroll > 0.0f) ? (editor.scrollY / maxScroll) * (trackHeight - thumbHeight) : 0.0f;
+
+            DrawCommand thumbCmd;
+            thumbCmd.type = DrawCommand::Type::RoundedRect;
+            thumbCmd.pos = pos + glm::vec2(editorSize.x - 10.0f, borderWidth + thumbY);
+            thumbCmd.size = glm::vec2(6.0f, thumbHeight);
+            thumbCmd.color = glm::vec4(0.2f, 0.2f, 0.2f, 0.3f);
+            thumbCmd.rounding = 3.0f;
+            AddDrawCommand(thumbCmd);
+        }
+
+        DrawCommand popScissorCmd;
+        popScissorCmd.type = DrawCommand::Type::PopScissor;
+        AddDrawCommand(popScissorCmd);
+
+        document.TrimLayouts(firstLine, lastLine);
+
+        layout.Advance(editorSize);
+        return document.GetVersion() != versionBefore;
+    }
+
     bool UIContext::InputFloat(const std::string& label, float* value, float step) {
         Text(label + ": [Input not implemented]");
         return false;
@@ -1052,7 +1636,7 @@ namespace Unicorn::UI {
         glm::vec2 pos = layout.cursor;
 
         Text(label);
-        pos = layout.cursor;
+        pos = PlaceItem(sliderSize);
 
         std::string id = GenerateID(label);
         WidgetState state = ProcessWidget(pos, sliderSize);
@@ -1109,19 +1693,16 @@ namespace Unicorn::UI {
             m_GlobalScroll.contentHeight - m_GlobalScroll.viewportSize.y
         );
 
-        m_GlobalScroll.physics.target.y = glm::clamp(
-            m_GlobalScroll.physics.target.y,
-            -m_GlobalScroll.maxScroll,
-            0.0f
-        );
-
-        m_GlobalScroll.physics.offset.y = glm::clamp(
-            m_GlobalScroll.physics.offset.y,
-            -m_GlobalScroll.maxScroll,
-            0.0f
-        );
+        ScrollPhysics& physics = *m_GlobalScroll.physics;
 
-        m_PageScrollOffsets[m_GlobalScroll.pageId] = m_GlobalScroll.physics.offset;
+        // Content shrank below the current position: jump back into range,
+        // or ease toward the new end if only the target overshoots
+        if (physics.offset.y < -m_GlobalScroll.maxScroll) {
+            SnapScroll(physics, glm::vec2(physics.offset.x, -m_GlobalScroll.maxScroll));
+        }
+        else if (physics.target.y < -m_GlobalScroll.maxScroll) {
+            StartScroll(physics, glm::vec2(physics.target.x, -m_GlobalScroll.maxScroll));
+        }
 
         bool mouseInViewport = IsPointInRect(m_MousePos, m_GlobalScroll.viewportPos, m_GlobalScroll.viewportSize);
 
@@ -1143,18 +1724,10 @@ namespace Unicorn::UI {
 
         if (mouseInViewport && !mouseInAnyPanel && !mouseOverScrollbar && m_MouseWheelDelta != 0.0f) {
             float scrollAmount = m_MouseWheelDelta * 200.0f;
-            m_GlobalScroll.physics.target.y += scrollAmount;
-
-            m_GlobalScroll.physics.target.y = glm::clamp(
-                m_GlobalScroll.physics.target.y,
-                -m_GlobalScroll.maxScroll,
-                0.0f
-            );
+            glm::vec2 target = physics.target;
+            target.y = glm::clamp(target.y + scrollAmount, -m_GlobalScroll.maxScroll, 0.0f);
 
-            m_GlobalScroll.physics.velocity.y += scrollAmount * 4.5f;
-            m_GlobalScroll.physics.hasInertia = true;
-
-            m_IsDirty = true;
+            StartScroll(physics, target, glm::vec2(0.0f, scrollAmount * 4.5f));
         }
 
         if (m_GlobalScroll.maxScroll > 1.0f) {
@@ -1169,7 +1742,7 @@ namespace Unicorn::UI {
             float scrollRatio = 0.0f;
             if (m_GlobalScroll.maxScroll > 0.0f) {
                 scrollRatio = glm::clamp(
-                    -m_GlobalScroll.physics.offset.y / m_GlobalScroll.maxScroll,
+                    -physics.offset.y / m_GlobalScroll.maxScroll,
                     0.0f, 1.0f
                 );
             }
@@ -1197,10 +1770,7 @@ namespace Unicorn::UI {
                 float deltaRatio = deltaY / (scrollbarHeight - thumbHeight);
                 float newScrollRatio = glm::clamp(dragStartScrollRatio + deltaRatio, 0.0f, 1.0f);
 
-                m_GlobalScroll.physics.target.y = -newScrollRatio * m_GlobalScroll.maxScroll;
-                m_GlobalScroll.physics.offset.y = m_GlobalScroll.physics.target.y;
-                m_GlobalScroll.physics.velocity = glm::vec2(0);
-                m_GlobalScroll.physics.hasInertia = false;
+                SnapScroll(physics, glm::vec2(physics.offset.x, -newScrollRatio * m_GlobalScroll.maxScroll));
 
                 m_IsDirty = true;
             }
@@ -1218,13 +1788,11 @@ namespace Unicorn::UI {
                 float clickY = m_MousePos.y - m_GlobalScroll.viewportPos.y;
                 float targetRatio = glm::clamp(clickY / scrollbarHeight, 0.0f, 1.0f);
 
-                m_GlobalScroll.physics.target.y = -targetRatio * m_GlobalScroll.maxScroll;
-
-                float distance = m_GlobalScroll.physics.target.y - m_GlobalScroll.physics.offset.y;
-                m_GlobalScroll.physics.velocity.y = distance * 8.0f;
-                m_GlobalScroll.physics.hasInertia = true;
+                glm::vec2 target(physics.target.x, -targetRatio * m_GlobalScroll.maxScroll);
 
-                m_IsDirty = true;
+                // Kick toward the click so the jump starts fast and eases out
+                float distance = target.y - physics.offset.y;
+                StartScroll(physics, target, glm::vec2(0.0f, distance * 8.0f - physics.velocity.y));
             }
 
             DrawCommand trackCmd;
@@ -1250,17 +1818,18 @@ namespace Unicorn::UI {
         }
 
         m_GlobalScroll.active = false;
+        m_GlobalScroll.physics = nullptr;
     }
 
 
     void UIContext::Panel(const glm::vec2& size, const std::function<void()>& content) {
-        auto& layout = m_LayoutStack.back();
-        glm::vec2 pos = layout.cursor;
+        glm::vec2 panelSize = size;
+        glm::vec2 pos = PlaceItem(panelSize);
 
         DrawCommand cmd;
         cmd.type = DrawCommand::Type::RoundedRect;
         cmd.pos = pos;
-        cmd.size = size;
+        cmd.size = panelSize;
         cmd.color = Unicorn::UI::Color::Panel;
         cmd.rounding = 6.0f;
         AddDrawCommand(cmd);
@@ -1272,7 +1841,7 @@ namespace Unicorn::UI {
         if (content) content();
 
         m_LayoutStack.pop_back();
-        layout.Advance(size);
+        m_LayoutStack.back().Advance(panelSize);
     }
 
     std::string UIContext::GenerateID(const std::string& label) {
@@ -1358,27 +1927,39 @@ namespace Unicorn::UI {
             return true;
         }
 
-        // Check panels
-        for (const auto& [id, region] : m_ScrollRegions) {
-            float velLength = glm::length(region.physics.velocity);
-            float dist = glm::distance(region.physics.offset, region.physics.target);
+        return !m_MovingScrolls.empty();
+    }
 
-            if (velLength > 0.1f || dist > 0.1f) {
-                return true;
+    bool UIContext::UpdateAnimations(double time) {
+        if (m_AnimController && m_AnimController->Update(time)) {
+            if (m_AnimController->HasActiveAnimations()) {
+                Application::Get().GetFramePacer().Request(FrameSource::Animation);
             }
+            m_IsDirty = true;
+            return true;
         }
+        return false;
+    }
 
-        // Check global
-        if (m_GlobalScroll.active) {
-            float velLength = glm::length(m_GlobalScroll.physics.velocity);
-            float dist = glm::distance(m_GlobalScroll.physics.offset, m_GlobalScroll.physics.target);
+    void UIContext::RequestFrame(FrameSource source) {
+        Application::Get().GetFramePacer().Request(source);
 
-            if (velLength > 0.1f || dist > 0.1f) {
-                return true;
-            }
+        if (m_AnimController) {
+            m_AnimController->ScheduleWakeup(m_AnimController->GetFrameTime());
         }
+    }
 
-        return false;
+    double UIContext::GetNextRedrawDeadline() const {
+        if (!m_AnimController) {
+            return AnimationController::NoDeadline;
+        }
+
+        // Scroll physics and running tweens need the very next frame
+        if (HasActiveAnimations()) {
+            return m_AnimController->GetFrameTime();
+        }
+
+        return m_AnimController->GetNextDeadline();
     }
 
     void UIContext::AddDrawCommand(const DrawCommand& cmd) {
@@ -1391,7 +1972,7 @@ namespace Unicorn::UI {
             case DrawCommand::Type::Text:
             case DrawCommand::Type::Line:
             case DrawCommand::Type::Icon:
-                modifiedCmd.pos.y += m_GlobalScroll.physics.offset.y;
+                modifiedCmd.pos.y += m_GlobalScroll.physics->offset.y;
                 break;
             default:
                 break;
@@ -1443,14 +2024,39 @@ namespace Unicorn::UI {
     }
 
     glm::vec2 UIContext::CalcTextSize(const std::string& text) {
+        // Plain text has no ID, so the text is its own key: the measurement
+        // follows it when rows above are added or removed. A label that keeps
+        // changing leaves one small entry per value until eviction. The tag
+        // keeps it apart from a widget ID spelled the same.
+        return MeasureText(LayoutCache::Hash(text) ^ 0x9E3779B97F4A7C15ull, text);
+    }
+
+    glm::vec2 UIContext::MeasureText(const std::string& id, const std::string& text) {
+        return MeasureText(LayoutCache::Hash(id), text);
+    }
+
+    glm::vec2 UIContext::MeasureText(uint64_t key, const std::string& text) {
+        // Shaping is the expensive part of layout: keep the last result until
+        // the text, the font generation or the shaping direction changes
+        int direction = m_Renderer
+            ? static_cast<int>(m_Renderer->GetFontManager().GetTextShaper().GetDirection()) : 0;
+        uint64_t contentHash = LayoutCache::Hash(text) * 31 + direction;
+
+        glm::vec2 size;
+        if (m_LayoutCache.FindMeasurement(key, contentHash, 0.0f, size)) {
+            return size;
+        }
+
+        // Ultimate fallback
+        size = glm::vec2(text.length() * 8.0f, 16.0f);
+
         // Use the renderer's font manager for accurate text size
         if (m_Renderer && m_Renderer->GetFontManager().GetTextShaper().GetDirection() != TextShaper::TextDirection::Auto) {
             auto& fontManager = m_Renderer->GetFontManager();
-            return fontManager.GetTextShaper().CalculateTextSize(text);
+            size = fontManager.GetTextShaper().CalculateTextSize(text);
         }
-
         // Fallback: use font manager's shaped text calculation
-        if (m_Renderer) {
+        else if (m_Renderer) {
             auto& fontManager = m_Renderer->GetFontManager();
             auto shapedGlyphs = fontManager.ShapeText(text);
 
@@ -1461,11 +2067,11 @@ namespace Unicorn::UI {
                 width += glyph.advance.x;
             }
 
-            return glm::vec2(width, height);
+            size = glm::vec2(width, height);
         }
 
-        // Ultimate fallback
-        return glm::vec2(text.length() * 8.0f, 16.0f);
+        m_LayoutCache.StoreMeasurement(key, contentHash, 0.0f, size);
+        return size;
     }
 
     bool UIContext::IsMouseButtonDown(int button) const {
@@ -1477,94 +2083,157 @@ namespace Unicorn::UI {
     }
 
 
-    void UIContext::UpdatePhysicsScroll(float dt) {
-        dt = glm::clamp(dt, 0.001f, 1.00f); // Cap at 30 FPS for stability
+    // ============================================================================
+    // SCROLL PHYSICS
+    // ============================================================================
+
+    void ScrollPhysics::Retarget(double time, const glm::vec2& newTarget, const glm::vec2& impulse) {
+        target = newTarget;
+        startTime = time;
+        startDisplacement = offset - target;
+        startVelocity = velocity + impulse;
+        velocity = startVelocity;
+
+        // x(t) = (x0 + (v0 + w*x0) t) e^(-w t). Its magnitude is bounded by
+        // (|x0| + |v0 + w*x0| t) e^(-w t); solve bound == settleDistance for t
+        // by fixed-point iteration (the bound is log-concave, so this
+        // converges monotonically from the peak time 1/w).
+        float omega = std::sqrt(springStiffness);
+        float a = glm::length(startDisplacement);
+        float b = glm::length(startVelocity + omega * startDisplacement);
+        float epsilon = settleDistance;
+
+        if (a <= epsilon && b <= epsilon * omega) {
+            SnapTo(target);
+            return;
+        }
 
-        for (auto& [id, region] : m_ScrollRegions) {
-            UpdateScrollPhysics(region.physics, dt);
+        double t = 1.0 / omega;
+        for (int i = 0; i < 24; i++) {
+            double next = std::log(std::max((a + b * t) / epsilon, 1.0)) / omega;
+            if (std::abs(next - t) < 1e-4) {
+                t = next;
+                break;
+            }
+            t = next;
         }
 
-        if (m_GlobalScroll.active) {
-            UpdateScrollPhysics(m_GlobalScroll.physics, dt);
+        settleTime = t;
+        moving = true;
+    }
+
+    void ScrollPhysics::SnapTo(const glm::vec2& value) {
+        offset = value;
+        target = value;
+        velocity = glm::vec2(0.0f);
+        settleTime = 0.0;
+        moving = false;
+    }
+
+    bool ScrollPhysics::Evaluate(double time) {
+        if (!moving) return false;
+
+        double t = time - startTime;
+        if (t >= settleTime) {
+            SnapTo(target);
+            return false;
         }
+
+        float omega = std::sqrt(springStiffness);
+        float ft = static_cast<float>(std::max(t, 0.0));
+        float decay = std::exp(-omega * ft);
+        glm::vec2 b = startVelocity + omega * startDisplacement;
+
+        offset = target + (startDisplacement + b * ft) * decay;
+        velocity = (startVelocity - omega * b * ft) * decay;
+        return true;
     }
 
-    void UIContext::UpdateScrollPhysics(ScrollPhysics& physics, float dt) {
-        // ========================================
-        // ULTRA SMOOTH SCROLL - Brave Browser Style
-        // ========================================
+    double UIContext::GetScrollTime() const {
+        return m_AnimController ? m_AnimController->GetFrameTime() : AnimationController::Now();
+    }
 
-        glm::vec2 displacement = physics.target - physics.offset;
-        float distance = glm::length(displacement);
+    void UIContext::StartScroll(ScrollPhysics& physics, const glm::vec2& target,
+        const glm::vec2& impulse) {
+        bool wasMoving = physics.moving;
+        physics.Retarget(GetScrollTime(), target, impulse);
 
-        // Stop threshold - very tight for instant stop
-        if (distance < 0.1f && glm::length(physics.velocity) < 0.1f) {
-            physics.offset = physics.target;
-            physics.velocity = glm::vec2(0);
-            physics.hasInertia = false;
-            return;
+        if (physics.moving && !wasMoving) {
+            m_MovingScrolls.push_back(&physics);
+        }
+        if (physics.moving) {
+            RequestFrame(FrameSource::Scroll);
         }
+        m_IsDirty = true;
+    }
+
+    void UIContext::SnapScroll(ScrollPhysics& physics, const glm::vec2& value) {
+        if (physics.offset == value && !physics.moving) return;
 
-        // Spring physics with high responsiveness
-        glm::vec2 springForce = displacement * physics.springStiffness;
-        glm::vec2 dampingForce = -physics.velocity * physics.springDamping;
-        glm::vec2 totalForce = springForce + dampingForce;
+        physics.SnapTo(value);
+        std::erase(m_MovingScrolls, &physics);
+        m_IsDirty = true;
+    }
 
-        physics.velocity += totalForce * dt;
+    void UIContext::UpdatePhysicsScroll(double time) {
+        if (m_MovingScrolls.empty()) return;
 
-        // Friction only during inertia
-        if (physics.hasInertia) {
-            physics.velocity *= physics.friction;
+        for (size_t i = 0; i < m_MovingScrolls.size();) {
+            ScrollPhysics* physics = m_MovingScrolls[i];
+            physics->Evaluate(time);
 
-            // Stop inertia when too slow
-            if (glm::length(physics.velocity) < 1.0f) {
-                physics.hasInertia = false;
+            if (!physics->moving) {
+                m_MovingScrolls[i] = m_MovingScrolls.back();
+                m_MovingScrolls.pop_back();
+            }
+            else {
+                i++;
             }
         }
 
-        physics.offset += physics.velocity * dt;
-
+        // This frame shows new offsets; keep frames coming only while
+        // something is still moving
         m_IsDirty = true;
+        if (!m_MovingScrolls.empty()) {
+            RequestFrame(FrameSource::Scroll);
+        }
     }
 
     void UIContext::BeginScrollablePanel(const std::string& id, const glm::vec2& size,
         BorderStyle borderStyle) {
-        auto& layout = m_LayoutStack.back();
-        glm::vec2 pos = layout.cursor;
+        glm::vec2 panelSize = size;
+        glm::vec2 pos = PlaceItem(panelSize);
 
         // Initialize scroll region if needed
         if (m_ScrollRegions.find(id) == m_ScrollRegions.end()) {
             ScrollableRegion region;
             region.id = id;
             region.pos = pos;
-            region.size = size;
+            region.size = panelSize;
             region.contentSize = glm::vec2(0, 0);
 
-            // Panel-specific physics
-            region.physics.friction = 0.90f;
-            region.physics.springStiffness = 400.0f;
-            region.physics.springDamping = 28.0f;
-            region.physics.minVelocity = 0.1f;
+            region.physics.springStiffness = m_DefaultPhysics.springStiffness;
+            region.physics.settleDistance = m_DefaultPhysics.settleDistance;
 
             m_ScrollRegions[id] = region;
         }
 
         auto& region = m_ScrollRegions[id];
         region.pos = pos;
-        region.size = size;
+        region.size = panelSize;
         m_ActiveScrollRegionID = id;
 
         float borderWidth = 1.0f;
         float rounding = 12.0f;
 
         // Draw border
-        DrawBorder(m_DrawCommands, pos, size, borderStyle, borderWidth, Unicorn::UI::Color::Border, rounding);
+        DrawBorder(m_DrawCommands, pos, panelSize, borderStyle, borderWidth, Unicorn::UI::Color::Border, rounding);
 
         // Draw background
         DrawCommand bgCmd;
         bgCmd.type = DrawCommand::Type::RoundedRect;
         bgCmd.pos = pos + glm::vec2(borderWidth, borderWidth);
-        bgCmd.size = size - glm::vec2(borderWidth * 2, borderWidth * 2);
+        bgCmd.size = panelSize - glm::vec2(borderWidth * 2, borderWidth * 2);
         bgCmd.color = Unicorn::UI::Color::White;
         bgCmd.rounding = rounding - borderWidth;
         AddDrawCommand(bgCmd);
@@ -1573,25 +2242,21 @@ namespace Unicorn::UI {
         DrawCommand scissorCmd;
         scissorCmd.type = DrawCommand::Type::PushScissor;
         scissorCmd.pos = pos + glm::vec2(borderWidth, borderWidth);
-        scissorCmd.size = size - glm::vec2(borderWidth * 2, borderWidth * 2);
+        scissorCmd.size = panelSize - glm::vec2(borderWidth * 2, borderWidth * 2);
         AddDrawCommand(scissorCmd);
 
         // Check if mouse is inside panel
-        bool mouseInPanel = IsPointInRect(m_MousePos, pos, size);
+        bool mouseInPanel = IsPointInRect(m_MousePos, pos, panelSize);
 
         // Handle mouse wheel scrolling
         if (mouseInPanel && m_MouseWheelDelta != 0.0f) {
             float scrollAmount = m_MouseWheelDelta * 180.0f;
-            region.physics.target.y += scrollAmount;
+            float maxScrollY = glm::max(0.0f, region.contentSize.y - panelSize.y + 20.0f);
 
-            float maxScrollY = glm::max(0.0f, region.contentSize.y - size.y + 20.0f);
-            region.physics.target.y = glm::clamp(region.physics.target.y, -maxScrollY, 0.0f);
+            glm::vec2 target = region.physics.target;
+            target.y = glm::clamp(target.y + scrollAmount, -maxScrollY, 0.0f);
 
-            // Add velocity
-            region.physics.velocity.y += scrollAmount * 4.0f;
-            region.physics.hasInertia = true;
-
-            m_IsDirty = true;
+            StartScroll(region.physics, target, glm::vec2(0.0f, scrollAmount * 4.0f));
         }
 
         // Create scrolled layout context
@@ -1609,21 +2274,14 @@ namespace Unicorn::UI {
 
         m_GlobalScroll.pageId = "page_" + std::to_string((int)pos.x) + "_" + std::to_string((int)pos.y);
 
-        if (m_PageScrollOffsets.find(m_GlobalScroll.pageId) != m_PageScrollOffsets.end()) {
-            m_GlobalScroll.physics.offset = m_PageScrollOffsets[m_GlobalScroll.pageId];
-            m_GlobalScroll.physics.target = m_PageScrollOffsets[m_GlobalScroll.pageId];
-        }
-        else {
-            m_GlobalScroll.physics.offset = glm::vec2(0, 0);
-            m_GlobalScroll.physics.target = glm::vec2(0, 0);
+        // Physics persist per page so a scroll started on one frame keeps
+        // integrating on the next instead of being reset
+        auto [it, inserted] = m_PageScrolls.try_emplace(m_GlobalScroll.pageId);
+        if (inserted) {
+            it->second.springStiffness = m_DefaultPhysics.springStiffness;
+            it->second.settleDistance = m_DefaultPhysics.settleDistance;
         }
-
-        m_GlobalScroll.physics.friction = 0.88f;
-        m_GlobalScroll.physics.springStiffness = 320.0f;
-        m_GlobalScroll.physics.springDamping = 24.0f;
-        m_GlobalScroll.physics.minVelocity = 0.1f;
-        m_GlobalScroll.physics.velocity = glm::vec2(0);
-        m_GlobalScroll.physics.hasInertia = false;
+        m_GlobalScroll.physics = &it->second;
     }
 
 
@@ -1660,12 +2318,10 @@ namespace Unicorn::UI {
             float thumbHeight = glm::max(30.0f, (panelHeight / contentHeight) * scrollbarHeight);
             float maxScroll = contentHeight - panelHeight;
 
-            // Clamp scroll offset
-            if (region.physics.target.y < -maxScroll) {
-                region.physics.target.y = -maxScroll;
-            }
-            if (region.physics.target.y > 0.0f) {
-                region.physics.target.y = 0.0f;
+            // Content shrank: ease back into range
+            float clampedTarget = glm::clamp(region.physics.target.y, -maxScroll, 0.0f);
+            if (clampedTarget != region.physics.target.y) {
+                StartScroll(region.physics, glm::vec2(region.physics.target.x, clampedTarget));
             }
 
             float scrollRatio = (maxScroll > 0) ? glm::clamp(-region.physics.offset.y / maxScroll, 0.0f, 1.0f) : 0.0f;
@@ -1698,14 +2354,36 @@ namespace Unicorn::UI {
         m_ActiveScrollRegionID.clear();
     }
 
+    void UIContext::DrawIcon(const std::string& iconName, const glm::vec2& pos, float size,
+        const glm::vec4& color) {
+        if (!m_IconManager) return;
+
+        const IconManager::Icon* icon = m_IconManager->GetIcon(iconName);
+        if (!icon) return;
+
+        // The field scales to any size; snapping the origin to the device grid
+        // keeps straight edges as crisp as the text next to them
+        DrawCommand iconCmd;
+        iconCmd.type = DrawCommand::Type::Icon;
+        iconCmd.pos = glm::floor(pos * m_ContentScale + 0.5f) / m_ContentScale;
+        iconCmd.size = glm::vec2(size);
+        iconCmd.textureID = icon->textureID;
+        iconCmd.uvMin = icon->uvMin;
+        iconCmd.uvMax = icon->uvMax;
+        iconCmd.color = color;
+        AddDrawCommand(iconCmd);
+    }
+
     bool UIContext::IconButton(const std::string& iconName,
         const glm::vec2& size,
         Alignment align) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 buttonSize = size;
-        glm::vec2 pos = layout.cursor;
+        bool inStack = layout.stack >= 0;
+        glm::vec2 pos = PlaceItem(buttonSize);
 
-        if (m_CurrentWindow) {
+        // Window-relative alignment only applies outside stacks
+        if (m_CurrentWindow && !inStack) {
             float availableWidth = m_CurrentWindow->size.x - 22.0f;
 
             switch (align) {
@@ -1744,30 +2422,9 @@ namespace Unicorn::UI {
             return state.clicked;
         }
 
-        auto& animState = m_AnimController->GetButtonState(id);
-        float deltaTime = m_DeltaTime > 0 ? m_DeltaTime : 0.016f;
-
-        const float hoverSpeed = 16.0f;
-        const float activeSpeed = 16.0f;
-
-        if (state.hovered) {
-            animState.hoverProgress = glm::min(1.0f, animState.hoverProgress + deltaTime * hoverSpeed);
-        }
-        else {
-            animState.hoverProgress = glm::max(0.0f, animState.hoverProgress - deltaTime * hoverSpeed);
-        }
-
-        if (state.active) {
-            animState.activeProgress = glm::min(1.0f, animState.activeProgress + deltaTime * activeSpeed);
-        }
-        else {
-            animState.activeProgress = glm::max(0.0f, animState.activeProgress - deltaTime * activeSpeed);
-        }
-
-        float smoothHover = animState.hoverProgress * animState.hoverProgress *
-            (3.0f - 2.0f * animState.hoverProgress);
-        float smoothActive = animState.activeProgress * animState.activeProgress *
-            (3.0f - 2.0f * animState.activeProgress);
+        auto animState = m_AnimController->UpdateButtonState(id, state.hovered, state.active);
+        float smoothHover = animState.hoverProgress;
+        float smoothActive = animState.activeProgress;
 
         float hoverScale = 1.0f + (smoothHover * 0.03f);
         float activeScale = 1.0f - (smoothActive * 0.04f);
@@ -1792,29 +2449,12 @@ namespace Unicorn::UI {
         bgCmd.rounding = 6.0f;
         AddDrawCommand(bgCmd);
 
-        if (m_IconManager) {
-            const IconManager::Icon* icon = m_IconManager->GetIcon(iconName);
-            if (icon) {
-                float iconSize = 20.0f;
-
-                glm::vec2 iconPos;
-                iconPos = finalPos + glm::vec2(
-                    (scaledSize.x - iconSize) * 0.5f,
-                    (scaledSize.y - iconSize) * 0.5f
-                );
-
-                DrawCommand iconCmd;
-                iconCmd.type = DrawCommand::Type::Icon;
-                iconCmd.pos = iconPos;
-                iconCmd.size = glm::vec2(iconSize, iconSize);
-                iconCmd.textureID = icon->textureID;
-
-                iconCmd.color = Unicorn::UI::Color::Black;
-
-
-                AddDrawCommand(iconCmd);
-            }
-        }
+        float iconSize = 20.0f;
+        glm::vec2 iconPos = finalPos + glm::vec2(
+            (scaledSize.x - iconSize) * 0.5f,
+            (scaledSize.y - iconSize) * 0.5f
+        );
+        DrawIcon(iconName, iconPos, iconSize, Unicorn::UI::Color::Black);
 
         if (align == Alignment::Left) {
             layout.Advance(buttonSize);
@@ -1832,9 +2472,11 @@ namespace Unicorn::UI {
         Alignment align) {
         auto& layout = m_LayoutStack.back();
         glm::vec2 buttonSize = size;
-        glm::vec2 pos = layout.cursor;
+        bool inStack = layout.stack >= 0;
+        glm::vec2 pos = PlaceItem(buttonSize);
 
-        if (m_CurrentWindow) {
+        // Window-relative alignment only applies outside stacks
+        if (m_CurrentWindow && !inStack) {
             float availableWidth = m_CurrentWindow->size.x - 20.0f;
 
             switch (align) {
@@ -1864,7 +2506,7 @@ namespace Unicorn::UI {
             AddDrawCommand(bgCmd);
 
             if (!label.empty()) {
-                glm::vec2 textSize = CalcTextSize(label);
+                glm::vec2 textSize = MeasureText(id, label);
                 glm::vec2 textPos = pos + (buttonSize - textSize) * 0.5f;
                 DrawCommand textCmd;
                 textCmd.type = DrawCommand::Type::Text;
@@ -1884,30 +2526,9 @@ namespace Unicorn::UI {
             return state.clicked;
         }
 
-        auto& animState = m_AnimController->GetButtonState(id);
-        float deltaTime = m_DeltaTime > 0 ? m_DeltaTime : 0.016f;
-
-        const float hoverSpeed = 16.0f;
-        const float activeSpeed = 16.0f;
-
-        if (state.hovered) {
-            animState.hoverProgress = glm::min(1.0f, animState.hoverProgress + deltaTime * hoverSpeed);
-        }
-        else {
-            animState.hoverProgress = glm::max(0.0f, animState.hoverProgress - deltaTime * hoverSpeed);
-        }
-
-        if (state.active) {
-            animState.activeProgress = glm::min(1.0f, animState.activeProgress + deltaTime * activeSpeed);
-        }
-        else {
-            animState.activeProgress = glm::max(0.0f, animState.activeProgress - deltaTime * activeSpeed);
-        }
-
-        float smoothHover = animState.hoverProgress * animState.hoverProgress *
-            (3.0f - 2.0f * animState.hoverProgress);
-        float smoothActive = animState.activeProgress * animState.activeProgress *
-            (3.0f - 2.0f * animState.activeProgress);
+        auto animState = m_AnimController->UpdateButtonState(id, state.hovered, state.active);
+        float smoothHover = animState.hoverProgress;
+        float smoothActive = animState.activeProgress;
 
         float hoverScale = 1.0f + (smoothHover * 0.03f);
         float activeScale = 1.0f - (smoothActive * 0.04f);
@@ -1932,38 +2553,28 @@ namespace Unicorn::UI {
         bgCmd.rounding = 6.0f;
         AddDrawCommand(bgCmd);
 
-        if (m_IconManager) {
-            const IconManager::Icon* icon = m_IconManager->GetIcon(iconName);
-            if (icon) {
-                float iconSize = 20.0f;
-
-                glm::vec2 iconPos;
-                if (label.empty()) {
-                    iconPos = finalPos + glm::vec2(
-                        (scaledSize.x - iconSize) * 0.5f,
-                        (scaledSize.y - iconSize) * 0.5f
-                    );
-                }
-                else {
-                    iconPos = finalPos + glm::vec2(8.0f, (scaledSize.y - iconSize) * 0.5f);
-                }
-
-                DrawCommand iconCmd;
-                iconCmd.type = DrawCommand::Type::Icon;
-                iconCmd.pos = iconPos;
-                iconCmd.size = glm::vec2(iconSize, iconSize);
-                iconCmd.textureID = icon->textureID;
-
-                iconCmd.color = Unicorn::UI::Color::Black;
-
-
-                AddDrawCommand(iconCmd);
-            }
+        float iconSize = 20.0f;
+        glm::vec2 iconPos;
+        if (label.empty()) {
+            iconPos = finalPos + glm::vec2(
+                (scaledSize.x - iconSize) * 0.5f,
+                (scaledSize.y - iconSize) * 0.5f
+            );
+        }
+        else if (IsLayoutRTL()) {
+            iconPos = finalPos + glm::vec2(scaledSize.x - 8.0f - iconSize, (scaledSize.y - iconSize) * 0.5f);
+        }
+        else {
+            iconPos = finalPos + glm::vec2(8.0f, (scaledSize.y - iconSize) * 0.5f);
         }
+        DrawIcon(iconName, iconPos, iconSize, Unicorn::UI::Color::Black);
 
         if (!label.empty()) {
-            glm::vec2 textSize = CalcTextSize(label);
+            glm::vec2 textSize = MeasureText(id, label);
             glm::vec2 textPos = finalPos + glm::vec2(36.0f, (scaledSize.y - textSize.y) * 0.5f);
+            if (IsLayoutRTL()) {
+                textPos.x = finalPos.x + scaledSize.x - 36.0f - textSize.x;
+            }
 
             DrawCommand textCmd;
             textCmd.type = DrawCommand::Type::Text;
@@ -2007,17 +2618,7 @@ namespace Unicorn::UI {
         }
 
         // Update animations
-        static auto lastTime = std::chrono::high_resolution_clock::now();
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
-        lastTime = currentTime;
-
-        if (m_AnimController) {
-            m_AnimController->Update(deltaTime);
-            if (m_AnimController->HasActiveAnimations()) {
-                m_IsDirty = true;
-            }
-        }
+        UpdateAnimations(AnimationController::Now());
     }
 
     bool UIContext::IsPointInRect(const glm::vec2& point, const glm::vec2& rectPos,
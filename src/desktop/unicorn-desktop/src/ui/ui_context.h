@@ -3,6 +3,9 @@
 #include "draw_command.h"
 #include "icon_manager.h"
 #include "ui_animation.h"
+#include "ui_layout.h"
+#include "text_document.h"
+#include "../core/frame_pacer.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -63,6 +66,9 @@ namespace Unicorn::UI {
 
         enum class Direction { Vertical, Horizontal } direction = Direction::Vertical;
 
+        // Index of the open BeginStack() this context belongs to, -1 otherwise
+        int stack = -1;
+
         void Advance(const glm::vec2& size) {
             if (direction == Direction::Vertical) {
                 cursor.y += size.y + spacing;
@@ -77,15 +83,28 @@ namespace Unicorn::UI {
         }
     };
 
+    // Critically damped spring toward 'target', evaluated in closed form from
+    // the state captured when it was last retargeted. Motion is identical at
+    // any frame rate and the time it takes to settle is known up front.
     struct ScrollPhysics {
         glm::vec2 velocity = { 0, 0 };
         glm::vec2 offset = { 0, 0 };
         glm::vec2 target = { 0, 0 };
-        float friction = 0.88f;
-        float springStiffness = 280.0f;
-        float springDamping = 22.0f;
-        float minVelocity = 0.5f;
-        bool hasInertia = false;
+        float springStiffness = 280.0f;     // omega^2, in 1/s^2
+        float settleDistance = 0.1f;        // Pixels from target at which motion ends
+
+        double startTime = 0.0;
+        double settleTime = 0.0;            // Seconds after startTime
+        glm::vec2 startDisplacement = { 0, 0 };
+        glm::vec2 startVelocity = { 0, 0 };
+        bool moving = false;
+
+        // Restart the spring from the current offset/velocity (plus 'impulse')
+        void Retarget(double time, const glm::vec2& newTarget, const glm::vec2& impulse = glm::vec2(0.0f));
+        // Jump to 'value' and stop
+        void SnapTo(const glm::vec2& value);
+        // Update offset/velocity for 'time'; false once the spring has settled
+        bool Evaluate(double time);
     };
 
     struct ScrollableRegion {
@@ -121,6 +140,20 @@ namespace Unicorn::UI {
         void Separator(float line, int weight);
         void NewLine();
 
+        // Measure-then-arrange containers. Children are placed from the
+        // measurements recorded last frame, so an unchanged stack is not
+        // re-arranged; a zero size component fits the content.
+        void BeginStack(const std::string& id, StackAxis axis,
+            const glm::vec2& size = glm::vec2(0.0f),
+            const StackStyle& style = StackStyle());
+        void EndStack();
+        void SetNextItemFlex(float grow, float shrink = 1.0f);
+
+        // Default direction for stacks using LayoutDirection::Auto
+        void SetLayoutDirection(LayoutDirection direction) { m_LayoutDirection = direction; }
+        LayoutDirection GetLayoutDirection() const { return m_LayoutDirection; }
+        LayoutCache& GetLayoutCache() { return m_LayoutCache; }
+
         bool Button(const std::string& label, const glm::vec2& size = glm::vec2(120, 30));
         bool ButtonWithIcon(const std::string& iconName,
             const std::string& label,
@@ -135,6 +168,9 @@ namespace Unicorn::UI {
         void TextRTL(const std::string& text);
         bool Checkbox(const std::string& label, bool* value);
         bool InputText(const std::string& label, std::string& buffer, size_t maxLength = 256);
+        // Multi-line editor; returns true when the document changed this frame
+        bool TextEditor(const std::string& label, TextDocument& document,
+            const glm::vec2& size = glm::vec2(400, 200));
         bool InputFloat(const std::string& label, float* value, float step = 1.0f);
         bool SliderFloat(const std::string& label, float* value, float min, float max);
 
@@ -163,6 +199,11 @@ namespace Unicorn::UI {
         void EndGlobalScroll();
 
         IconManager& GetIconManager() { return *m_IconManager; }
+
+        // Device pixels per UI unit. Icons are rasterized and placed on this
+        // grid. The renderer currently draws 1:1 in framebuffer pixels.
+        void SetContentScale(float scale) { m_ContentScale = glm::max(scale, 0.25f); }
+        float GetContentScale() const { return m_ContentScale; }
         AnimationController& GetAnimController() { return *m_AnimController; }
 
         void CheckInputChanges();
@@ -171,16 +212,22 @@ namespace Unicorn::UI {
         bool IsDirty() const { return m_IsDirty; }
         void ClearDirty() { m_IsDirty = false; }
 
+        // Icon fields finished by the workers and waiting for BeginFrame
+        bool HasPendingIconUploads() const { return m_IconManager && m_IconManager->HasPendingUploads(); }
+
         bool HasActiveAnimations() const;
 
-        void UpdateAnimations(float dt) {
-            if (m_AnimController) {
-                m_AnimController->Update(dt);
-                if (m_AnimController->HasActiveAnimations()) {
-                    m_IsDirty = true;
-                }
-            }
-        }
+        // Advance animation time; marks the UI dirty while anything animates
+        // or a scheduled wakeup has been reached
+        bool UpdateAnimations(double time);
+
+        // Absolute time (AnimationController::Now) of the next required redraw,
+        // or AnimationController::NoDeadline when the UI is fully at rest
+        double GetNextRedrawDeadline() const;
+
+        // Keep frames coming on behalf of 'source'; the frame pacer applies the
+        // source's rate cap (SetSourceCap, e.g. animations held to 30 Hz)
+        void RequestFrame(FrameSource source);
 
         glm::vec2 GetScrolledMousePos() const {
             if (!m_ActiveScrollRegionID.empty()) {
@@ -192,10 +239,9 @@ namespace Unicorn::UI {
             return m_MousePos;
         }
 
-        void SetScrollPhysics(float friction, float stiffness, float damping) {
-            m_DefaultPhysics.friction = friction;
+        // Spring stiffness used by scroll panels and pages created from now on
+        void SetScrollPhysics(float stiffness) {
             m_DefaultPhysics.springStiffness = stiffness;
-            m_DefaultPhysics.springDamping = damping;
         }
 
         bool IsPointInRect(const glm::vec2& point, const glm::vec2& rectPos,
@@ -207,10 +253,22 @@ namespace Unicorn::UI {
         WidgetState ProcessWidget(const glm::vec2& pos, const glm::vec2& size);
         void AddDrawCommand(const DrawCommand& cmd);
         glm::vec2 CalcTextSize(const std::string& text);
+        glm::vec2 MeasureText(const std::string& id, const std::string& text);
+        glm::vec2 MeasureText(uint64_t key, const std::string& text);
+
+        // Claim the next slot of the current layout. Inside a stack this returns
+        // the arranged position and may resize 'size' (grow/shrink/stretch).
+        glm::vec2 PlaceItem(glm::vec2& size);
+        bool IsLayoutRTL() const;
+        void DrawIcon(const std::string& iconName, const glm::vec2& pos, float size,
+            const glm::vec4& color);
         size_t GetCursorPositionFromX(const std::string& text, float targetX);
 
-        void UpdatePhysicsScroll(float dt);
-        void UpdateScrollPhysics(ScrollPhysics& physics, float dt);
+        void UpdatePhysicsScroll(double time);
+        void StartScroll(ScrollPhysics& physics, const glm::vec2& target,
+            const glm::vec2& impulse = glm::vec2(0.0f));
+        void SnapScroll(ScrollPhysics& physics, const glm::vec2& value);
+        double GetScrollTime() const;
 
         int m_CurrentCursor = 0;
 
@@ -221,6 +279,18 @@ namespace Unicorn::UI {
         std::unordered_set<std::string> m_LastHoveredWidgets;
         std::unique_ptr<UIRenderer> m_Renderer;
         std::vector<LayoutContext> m_LayoutStack;
+
+        struct OpenStack {
+            LayoutCache::StackRecord* record = nullptr;
+            glm::vec2 origin = { 0.0f, 0.0f };
+            std::vector<FlexItem> measured;
+            std::vector<ArrangedItem> placed;   // Where children were drawn this frame
+            std::vector<size_t> firstCommand;   // First draw command of each child
+        };
+        std::vector<OpenStack> m_OpenStacks;
+        LayoutCache m_LayoutCache;
+        FlexItem m_NextItemFlex;
+        LayoutDirection m_LayoutDirection = LayoutDirection::LTR;
         std::vector<DrawCommand> m_DrawCommands;
         std::vector<std::string> m_IDStack;
         std::unordered_map<std::string, ScrollableRegion> m_ScrollRegions;
@@ -239,10 +309,13 @@ namespace Unicorn::UI {
         std::string* m_ActiveInputBuffer = nullptr;
         bool m_BackspaceHandled = false;
 
+        std::string m_ActiveEditorID;
+
         float m_DeltaTime = 0.0f;
         int m_FrameCount = 0;
 
         bool m_IsDirty = true;
+        float m_ContentScale = 1.0f;
 
         struct GlobalScroll {
             bool active = false;
@@ -251,11 +324,16 @@ namespace Unicorn::UI {
             float contentHeight = 0;
             float maxScroll = 0;
             float lastWindowBottom = 0;
-            std::string pageId;  // ADD THIS - to track per-page scroll
-            ScrollPhysics physics;
+            std::string pageId;
+            ScrollPhysics* physics = nullptr;   // Entry in m_PageScrolls
         } m_GlobalScroll;
 
-        std::unordered_map<std::string, glm::vec2> m_PageScrollOffsets;
+        // Scroll state per page, kept across frames and page switches
+        std::unordered_map<std::string, ScrollPhysics> m_PageScrolls;
+
+        // Springs that are still moving. Only these are evaluated each frame;
+        // an idle UI has an empty set and schedules no scroll frames.
+        std::vector<ScrollPhysics*> m_MovingScrolls;
 
         ScrollPhysics m_DefaultPhysics;
 
@@ -0,0 +1,184 @@
+#include "ui_layout.h"
+#include <algorithm>
+
+namespace Unicorn::UI {
+
+    // ============================================================================
+    // ARRANGE PASS
+    // ============================================================================
+
+    glm::vec2 MeasureStack(StackAxis axis, const StackStyle& style,
+        const std::vector<FlexItem>& items) {
+        const int main = axis == StackAxis::Horizontal ? 0 : 1;
+        const int cross = 1 - main;
+
+        glm::vec2 size(0.0f);
+        for (const auto& item : items) {
+            size[main] += item.basis[main];
+            size[cross] = std::max(size[cross], item.basis[cross]);
+        }
+        if (!items.empty()) {
+            size[main] += style.spacing * static_cast<float>(items.size() - 1);
+        }
+
+        return size + glm::vec2(style.padding * 2.0f);
+    }
+
+    glm::vec2 ArrangeStack(StackAxis axis, const StackStyle& style, bool rtl,
+        const glm::vec2& available, const std::vector<FlexItem>& items,
+        std::vector<ArrangedItem>& out) {
+        const int main = axis == StackAxis::Horizontal ? 0 : 1;
+        const int cross = 1 - main;
+
+        glm::vec2 natural = MeasureStack(axis, style, items);
+        glm::vec2 outer(
+            available.x > 0.0f ? available.x : natural.x,
+            available.y > 0.0f ? available.y : natural.y);
+        glm::vec2 inner = glm::max(outer - glm::vec2(style.padding * 2.0f), glm::vec2(0.0f));
+
+        out.resize(items.size());
+
+        // Main axis: grow into leftover space, or shrink proportionally to
+        // shrink * basis when the children overflow
+        float freeSpace = outer[main] - natural[main];
+        float totalGrow = 0.0f;
+        float totalScaledShrink = 0.0f;
+        for (const auto& item : items) {
+            totalGrow += item.grow;
+            totalScaledShrink += item.shrink * item.basis[main];
+        }
+
+        for (size_t i = 0; i < items.size(); i++) {
+            const FlexItem& item = items[i];
+            float length = item.basis[main];
+
+            if (freeSpace > 0.0f && totalGrow > 0.0f) {
+                length += freeSpace * (item.grow / totalGrow);
+            }
+            else if (freeSpace < 0.0f && totalScaledShrink > 0.0f) {
+                length += freeSpace * (item.shrink * item.basis[main] / totalScaledShrink);
+            }
+
+            out[i].size[main] = std::max(0.0f, length);
+            out[i].size[cross] = style.crossAlign == StackAlign::Stretch
+                ? inner[cross] : item.basis[cross];
+        }
+
+        // Positions, mirrored on the horizontal axis for RTL
+        float cursor = style.padding;
+        for (auto& arranged : out) {
+            float crossOffset = 0.0f;
+            float crossSlack = inner[cross] - arranged.size[cross];
+            StackAlign align = style.crossAlign;
+            if (rtl && cross == 0) {
+                if (align == StackAlign::Start) align = StackAlign::End;
+                else if (align == StackAlign::End) align = StackAlign::Start;
+            }
+            if (align == StackAlign::Center) crossOffset = crossSlack * 0.5f;
+            else if (align == StackAlign::End) crossOffset = crossSlack;
+
+            arranged.pos[main] = cursor;
+            arranged.pos[cross] = style.padding + crossOffset;
+            cursor += arranged.size[main] + style.spacing;
+
+            if (rtl && main == 0) {
+                arranged.pos.x = outer.x - arranged.pos.x - arranged.size.x;
+            }
+        }
+
+        return outer;
+    }
+
+    // ============================================================================
+    // LAYOUT CACHE
+    // ============================================================================
+
+    uint64_t LayoutCache::Hash(std::string_view data) {
+        // FNV-1a, 64-bit
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void LayoutCache::BeginFrame(uint32_t fontGeneration) {
+        m_Frame++;
+
+        if (fontGeneration != m_FontGeneration) {
+            m_FontGeneration = fontGeneration;
+            m_Measurements.clear();
+        }
+
+        if (m_Frame % 120 == 0) {
+            std::erase_if(m_Measurements, [this](const auto& entry) {
+                return m_Frame - entry.second.lastUsedFrame > s_EvictAfterFrames;
+            });
+            std::erase_if(m_Stacks, [this](const auto& entry) {
+                return m_Frame - entry.second.lastUsedFrame > s_EvictAfterFrames;
+            });
+        }
+
+        m_Stats.entries = m_Measurements.size() + m_Stacks.size();
+    }
+
+    bool LayoutCache::FindMeasurement(uint64_t key, uint64_t contentHash,
+        float constraint, glm::vec2& outSize) {
+        auto it = m_Measurements.find(key);
+        if (it == m_Measurements.end() ||
+            it->second.contentHash != contentHash ||
+            it->second.constraint != constraint) {
+            m_Stats.measureMisses++;
+            return false;
+        }
+
+        it->second.lastUsedFrame = m_Frame;
+        outSize = it->second.size;
+        m_Stats.measureHits++;
+        return true;
+    }
+
+    void LayoutCache::StoreMeasurement(uint64_t key, uint64_t contentHash,
+        float constraint, const glm::vec2& size) {
+        MeasureEntry& entry = m_Measurements[key];
+        entry.contentHash = contentHash;
+        entry.constraint = constraint;
+        entry.size = size;
+        entry.lastUsedFrame = m_Frame;
+    }
+
+    LayoutCache::StackRecord& LayoutCache::GetStack(const std::string& id) {
+        StackRecord& record = m_Stacks[id];
+        record.lastUsedFrame = m_Frame;
+        return record;
+    }
+
+    bool LayoutCache::Arrange(StackRecord& record, StackAxis axis, const StackStyle& style,
+        bool rtl, const glm::vec2& available) {
+        bool unchanged = !record.dirty && record.axis == axis && record.style == style &&
+            record.rtl == rtl && record.available == available &&
+            record.arranged.size() == record.items.size();
+
+        if (unchanged) {
+            m_Stats.arrangeReused++;
+            return false;
+        }
+
+        record.axis = axis;
+        record.style = style;
+        record.rtl = rtl;
+        record.available = available;
+        record.dirty = false;
+        record.size = ArrangeStack(axis, style, rtl, available, record.items, record.arranged);
+        record.naturalSize = MeasureStack(axis, style, record.items);
+        m_Stats.arrangeRuns++;
+        return true;
+    }
+
+    void LayoutCache::Clear() {
+        m_Measurements.clear();
+        m_Stacks.clear();
+    }
+
+} // namespace Unicorn::UI
@@ -0,0 +1,140 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Unicorn::UI {
+
+    enum class StackAxis {
+        Horizontal,
+        Vertical
+    };
+
+    // Placement of children on the cross axis
+    enum class StackAlign {
+        Start,
+        Center,
+        End,
+        Stretch
+    };
+
+    enum class LayoutDirection {
+        Auto,   // Inherit from the parent stack / UIContext
+        LTR,
+        RTL
+    };
+
+    struct StackStyle {
+        float spacing = 8.0f;
+        float padding = 0.0f;
+        StackAlign crossAlign = StackAlign::Start;
+        LayoutDirection direction = LayoutDirection::Auto;
+
+        bool operator==(const StackStyle& other) const {
+            return spacing == other.spacing && padding == other.padding &&
+                crossAlign == other.crossAlign && direction == other.direction;
+        }
+    };
+
+    // One child of a stack as reported by the measure pass
+    struct FlexItem {
+        glm::vec2 basis = { 0.0f, 0.0f };   // Natural (measured) size
+        float grow = 0.0f;                  // Share of leftover main-axis space
+        float shrink = 1.0f;                // Share of overflow, weighted by basis
+
+        bool operator==(const FlexItem& other) const {
+            return basis == other.basis && grow == other.grow && shrink == other.shrink;
+        }
+        bool operator!=(const FlexItem& other) const { return !(*this == other); }
+    };
+
+    struct ArrangedItem {
+        glm::vec2 pos = { 0.0f, 0.0f };     // Relative to the stack origin
+        glm::vec2 size = { 0.0f, 0.0f };
+    };
+
+    // Arrange pass: distributes free main-axis space by grow (or overflow by
+    // shrink * basis), aligns on the cross axis and mirrors horizontally when
+    // 'rtl' is set. A zero component in 'available' means "fit content".
+    // Returns the outer size of the stack.
+    glm::vec2 ArrangeStack(StackAxis axis, const StackStyle& style, bool rtl,
+        const glm::vec2& available, const std::vector<FlexItem>& items,
+        std::vector<ArrangedItem>& out);
+
+    // Natural (fit-content) outer size of a stack, ignoring grow/shrink
+    glm::vec2 MeasureStack(StackAxis axis, const StackStyle& style,
+        const std::vector<FlexItem>& items);
+
+    // Per-ID measurement and arrangement cache. A measurement stays valid until
+    // the widget's content hash, the font generation or its constraint changes;
+    // a stack is only re-arranged when one of its inputs differs from last frame.
+    // Measurements are keyed by a 64-bit hash of the widget ID, so looking one
+    // up builds no string.
+    class LayoutCache {
+    public:
+        struct StackRecord {
+            StackAxis axis = StackAxis::Vertical;
+            StackStyle style;
+            bool rtl = false;
+            glm::vec2 available = { 0.0f, 0.0f };
+            std::vector<FlexItem> items;
+
+            std::vector<ArrangedItem> arranged;
+            glm::vec2 size = { 0.0f, 0.0f };        // Outer size after arrange
+            glm::vec2 naturalSize = { 0.0f, 0.0f }; // Fit-content size (basis for the parent)
+            uint32_t lastUsedFrame = 0;
+            bool dirty = true;                      // Items changed since last arrange
+        };
+
+        struct Stats {
+            uint64_t measureHits = 0;
+            uint64_t measureMisses = 0;
+            uint64_t arrangeReused = 0;
+            uint64_t arrangeRuns = 0;
+            size_t entries = 0;
+        };
+
+        static uint64_t Hash(std::string_view data);
+
+        // Call once per frame; drops everything when the font generation moved
+        // and periodically evicts entries that were not touched recently
+        void BeginFrame(uint32_t fontGeneration);
+
+        bool FindMeasurement(uint64_t key, uint64_t contentHash,
+            float constraint, glm::vec2& outSize);
+        void StoreMeasurement(uint64_t key, uint64_t contentHash,
+            float constraint, const glm::vec2& size);
+
+        // Record for stack 'id'; stays valid for the whole frame
+        StackRecord& GetStack(const std::string& id);
+
+        // Re-arrange 'record' if any input changed; returns true if it did
+        bool Arrange(StackRecord& record, StackAxis axis, const StackStyle& style,
+            bool rtl, const glm::vec2& available);
+
+        void Clear();
+
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct MeasureEntry {
+            uint64_t contentHash = 0;
+            float constraint = 0.0f;
+            glm::vec2 size = { 0.0f, 0.0f };
+            uint32_t lastUsedFrame = 0;
+        };
+
+        std::unordered_map<uint64_t, MeasureEntry> m_Measurements;
+        std::unordered_map<std::string, StackRecord> m_Stacks;
+
+        uint32_t m_Frame = 0;
+        uint32_t m_FontGeneration = 0;
+        Stats m_Stats;
+
+        static constexpr uint32_t s_EvictAfterFrames = 600;
+    };
+
+} // namespace Unicorn::UI
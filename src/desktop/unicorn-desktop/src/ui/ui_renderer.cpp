@@ -19,6 +19,7 @@ namespace Unicorn::UI {
         layout(location = 3) in vec2 a_RectPos;
         layout(location = 4) in vec2 a_RectSize;
         layout(location = 5) in float a_Rounding;
+        layout(location = 6) in float a_Textured;
         
         uniform mat4 u_Projection;
         
@@ -28,6 +29,7 @@ namespace Unicorn::UI {
         out vec2 v_RectPos;
         out vec2 v_RectSize;
         out float v_Rounding;
+        out float v_Textured;
         
         void main() {
             v_Color = a_Color;
@@ -36,6 +38,7 @@ namespace Unicorn::UI {
             v_RectPos = a_RectPos;
             v_RectSize = a_RectSize;
             v_Rounding = a_Rounding;
+            v_Textured = a_Textured;
             gl_Position = u_Projection * vec4(a_Position, 0.0, 1.0);
         }
     )";
@@ -49,6 +52,9 @@ namespace Unicorn::UI {
         in vec2 v_RectPos;
         in vec2 v_RectSize;
         in float v_Rounding;
+        in float v_Textured;
+        
+        uniform sampler2D u_IconAtlas;
         
         out vec4 FragColor;
         
@@ -58,7 +64,14 @@ namespace Unicorn::UI {
         }
         
         void main() {
-            if (v_Rounding > 0.5) {
+            if (v_Textured > 0.5) {
+                // Icon: signed distance field (0.5 = edge), antialiased over
+                // one screen pixel whatever size the icon is drawn at
+                float distance = texture(u_IconAtlas, v_TexCoord).r - 0.5;
+                float width = max(fwidth(distance), 1e-4);
+                float coverage = smoothstep(-width, width, distance);
+                FragColor = vec4(v_Color.rgb, v_Color.a * coverage);
+            } else if (v_Rounding > 0.5) {
                 // Calculate distance from rounded rectangle edge
                 vec2 rectCenter = v_RectPos + v_RectSize * 0.5;
                 vec2 fragToCenter = v_FragPos - rectCenter;
@@ -270,6 +283,10 @@ namespace Unicorn::UI {
             glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(UIVertex),
                 (void*)offsetof(UIVertex, rounding));
 
+            glEnableVertexAttribArray(6);
+            glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, sizeof(UIVertex),
+                (void*)offsetof(UIVertex, textured));
+
             glBindVertexArray(0);
             std::cout << "[UIRenderer]   ✓ Shape buffers created" << std::endl;
 
@@ -494,17 +511,20 @@ namespace Unicorn::UI {
                 DrawText(cmd.pos, cmd.text, cmd.color);
                 break;
             case DrawCommand::Type::Icon:
-                // Flush shapes before rendering icon
-                if (!m_VertexBuffer.empty()) {
-                    FlushBatch();
-                    m_VertexBuffer.clear();
-                    m_IndexBuffer.clear();
+                if (cmd.textureID == 0) break;
+
+                // Icons share one atlas, so this only flushes if a different
+                // texture shows up mid-batch
+                if (cmd.textureID != m_BatchTexture) {
+                    if (!m_VertexBuffer.empty()) {
+                        FlushBatch();
+                        m_VertexBuffer.clear();
+                        m_IndexBuffer.clear();
+                    }
+                    m_BatchTexture = cmd.textureID;
                 }
 
-                // Render icon as textured quad
-                if (cmd.textureID != 0) {
-                    DrawIcon(cmd.pos, cmd.size, cmd.textureID, cmd.color);
-                }
+                AddIconQuad(cmd.pos, cmd.size, cmd.uvMin, cmd.uvMax, cmd.color);
                 break;
             }
         }
@@ -739,6 +759,10 @@ namespace Unicorn::UI {
         glUniformMatrix4fv(glGetUniformLocation(m_ShaderProgram, "u_Projection"),
             1, GL_FALSE, &m_Projection[0][0]);
 
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_BatchTexture);
+        glUniform1i(glGetUniformLocation(m_ShaderProgram, "u_IconAtlas"), 0);
+
         glBindVertexArray(m_VAO);
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
         glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexBuffer.size() * sizeof(UIVertex),
@@ -756,53 +780,26 @@ namespace Unicorn::UI {
         }
 
         glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
         glUseProgram(0);
         glDisable(GL_BLEND);
     }
 
-    void UIRenderer::DrawIcon(const glm::vec2& pos, const glm::vec2& size,
-        uint32_t textureID, const glm::vec4& color) {
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        glUseProgram(m_TextShaderProgram);
-        glUniformMatrix4fv(glGetUniformLocation(m_TextShaderProgram, "projection"),
-            1, GL_FALSE, &m_Projection[0][0]);
-        glUniform4f(glGetUniformLocation(m_TextShaderProgram, "textColor"),
-            color.r, color.g, color.b, color.a);
-        glUniform1i(glGetUniformLocation(m_TextShaderProgram, "useSubpixel"), 0);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glBindVertexArray(m_TextVAO);
-
-        float vertices[6][4] = {
-            { pos.x,          pos.y + size.y,  0.0f, 1.0f },
-            { pos.x,          pos.y,           0.0f, 0.0f },
-            { pos.x + size.x, pos.y,           1.0f, 0.0f },
-
-            { pos.x,          pos.y + size.y,  0.0f, 1.0f },
-            { pos.x + size.x, pos.y,           1.0f, 0.0f },
-            { pos.x + size.x, pos.y + size.y,  1.0f, 1.0f }
-        };
-
-        glBindBuffer(GL_ARRAY_BUFFER, m_TextVBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    void UIRenderer::AddIconQuad(const glm::vec2& pos, const glm::vec2& size,
+        const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color) {
+        uint32_t indexStart = (uint32_t)m_VertexBuffer.size();
 
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        m_VertexBuffer.push_back({ pos, color, uvMin, pos, size, 0.0f, 1.0f });
+        m_VertexBuffer.push_back({ pos + glm::vec2(size.x, 0), color, { uvMax.x, uvMin.y }, pos, size, 0.0f, 1.0f });
+        m_VertexBuffer.push_back({ pos + size, color, uvMax, pos, size, 0.0f, 1.0f });
+        m_VertexBuffer.push_back({ pos + glm::vec2(0, size.y), color, { uvMin.x, uvMax.y }, pos, size, 0.0f, 1.0f });
 
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glUseProgram(0);
-        glDisable(GL_BLEND);
+        m_IndexBuffer.push_back(indexStart + 0);
+        m_IndexBuffer.push_back(indexStart + 1);
+        m_IndexBuffer.push_back(indexStart + 2);
+        m_IndexBuffer.push_back(indexStart + 2);
+        m_IndexBuffer.push_back(indexStart + 3);
+        m_IndexBuffer.push_back(indexStart + 0);
     }
 
 } // namespace Unicorn::UI
\ No newline at end of file
@@ -18,6 +18,7 @@ namespace Unicorn::UI {
         glm::vec2 rectPos;      // Rectangle position for SDF
         glm::vec2 rectSize;     // Rectangle size for SDF
         float rounding;         // Corner rounding radius
+        float textured = 0.0f;  // 1 = alpha from the icon atlas at texCoord
     };
 
     enum class MSAAMode {
@@ -67,8 +68,8 @@ namespace Unicorn::UI {
         void InitTextShaders();
         void AddQuad(const glm::vec2& pos, const glm::vec2& size, const glm::vec4& color,
             const glm::vec2& rectPos, const glm::vec2& rectSize, float rounding);
-        void DrawIcon(const glm::vec2& pos, const glm::vec2& size,
-            uint32_t textureID, const glm::vec4& color);
+        void AddIconQuad(const glm::vec2& pos, const glm::vec2& size,
+            const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color);
 
         static constexpr size_t MaxVertices = 10000;
         static constexpr size_t MaxIndices = 15000;
@@ -83,6 +84,7 @@ namespace Unicorn::UI {
         uint32_t m_TextVBO = 0;
 
         uint32_t m_ShaderProgram = 0;
+        uint32_t m_BatchTexture = 0;    // Icon atlas sampled by the current batch
         uint32_t m_TextShaderProgram = 0;
 
         glm::mat4 m_Projection;
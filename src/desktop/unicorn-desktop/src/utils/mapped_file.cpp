@@ -0,0 +1,106 @@
+#include "mapped_file.h"
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Unicorn {
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        std::filesystem::path filePath(path);
+        HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_File = file;
+        m_Mapping = mapping;
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (m_Data) UnmapViewOfFile(m_Data);
+        if (m_Mapping) CloseHandle(m_Mapping);
+        if (m_File) CloseHandle(m_File);
+
+        m_Data = nullptr;
+        m_Mapping = nullptr;
+        m_File = nullptr;
+        m_Size = 0;
+    }
+#else
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // The mapping keeps the file referenced
+
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (m_Data) {
+            munmap(const_cast<uint8_t*>(m_Data), m_Size);
+        }
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+
+} // namespace Unicorn
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace Unicorn {
+
+    // Read-only memory mapping of a whole file. The mapping reflects the file
+    // size at Open(); bytes appended afterwards are not visible until reopened.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const uint8_t* Data() const { return m_Data; }
+        size_t Size() const { return m_Size; }
+
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+    };
+
+} // namespace Unicorn
@@ -0,0 +1,827 @@
+#include "hrms_stub_server.h"
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace Unicorn::Tools {
+
+    // ============================================================================
+    // SOCKETS
+    // ============================================================================
+
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+    static constexpr int s_SendFlags = 0;
+    static constexpr int s_ShutdownBoth = SD_BOTH;
+
+    static void CloseSocket(intptr_t socket) {
+        closesocket(static_cast<SocketHandle>(socket));
+    }
+#else
+    using SocketHandle = int;
+    static constexpr int s_SendFlags = MSG_NOSIGNAL;
+    static constexpr int s_ShutdownBoth = SHUT_RDWR;
+
+    static void CloseSocket(intptr_t socket) {
+        close(static_cast<SocketHandle>(socket));
+    }
+#endif
+
+    static bool SendAll(intptr_t socket, const char* data, size_t size) {
+        while (size > 0) {
+            int chunk = static_cast<int>(std::min<size_t>(size, 1 << 20));
+            int sent = send(static_cast<SocketHandle>(socket), data, chunk, s_SendFlags);
+            if (sent <= 0) return false;
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    static constexpr size_t s_MaxHeaderBytes = 64 * 1024;
+    static constexpr size_t s_MaxBodyBytes = 16 * 1024 * 1024;
+    static constexpr std::chrono::seconds s_EventHeartbeat{ 15 };
+
+    // ============================================================================
+    // SYNTHETIC DATA
+    // ============================================================================
+
+    static const char* s_FirstNames[] = {
+        "Ana", "Ben", "Chloe", "David", "Elif", "Farah", "George", "Hana", "Ivan", "Julia",
+        "Kenji", "Lena", "Mateo", "Nadia", "Omar", "Priya", "Quentin", "Rosa", "Samir", "Tara"
+    };
+    static const char* s_LastNames[] = {
+        "Silva", "Nguyen", "Schmidt", "Okafor", "Rossi", "Kowalski", "Haddad", "Tanaka",
+        "Novak", "Garcia", "Larsen", "Petrov", "Dubois", "Kaya", "Mensah", "Ahmed"
+    };
+    static const char* s_Departments[] = {
+        "Engineering", "Finance", "Human Resources", "Operations", "Sales", "Support"
+    };
+    static const char* s_Positions[] = {
+        "Software Engineer", "Accountant", "HR Specialist", "Operations Analyst",
+        "Account Executive", "Support Engineer", "Team Lead", "Manager"
+    };
+    static const char* s_Cities[] = { "Lisbon", "Berlin", "Nairobi", "Osaka", "Toronto", "Warsaw" };
+    static const char* s_LeaveTypes[] = { "Annual", "Sick", "Personal", "Unpaid" };
+
+    template<size_t N>
+    static const char* Pick(const char* (&values)[N], uint64_t hash) {
+        return values[hash % N];
+    }
+
+    // splitmix64: the same inputs always give the same record
+    static uint64_t Hash(uint64_t a, uint64_t b = 0) {
+        uint64_t x = a * 0x9E3779B97F4A7C15ull + b + 0x632BE59BD9B4E019ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static std::string FormatDate(int dayNumber) {
+        std::chrono::year_month_day date{ std::chrono::sys_days{ std::chrono::days{ dayNumber } } };
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT00:00:00",
+            static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+        return buffer;
+    }
+
+    // "yyyy-mm-dd..." to days since the epoch; false if it is not a date
+    static bool ParseDate(const std::string& text, int& dayNumber) {
+        int year = 0;
+        unsigned month = 0, day = 0;
+        if (std::sscanf(text.c_str(), "%4d-%2u-%2u", &year, &month, &day) != 3) return false;
+
+        std::chrono::year_month_day date{ std::chrono::year{ year }, std::chrono::month{ month }, std::chrono::day{ day } };
+        if (!date.ok()) return false;
+        dayNumber = static_cast<int>(std::chrono::sys_days{ date }.time_since_epoch().count());
+        return true;
+    }
+
+    static std::string FormatTime(int minutes) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%02d:%02d:00", minutes / 60, minutes % 60);
+        return buffer;
+    }
+
+    // "yyyy-mm-ddThh:mm:ssZ", as in the webhook payloads
+    static std::string FormatTimestamp(std::chrono::system_clock::time_point time) {
+        auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+        auto day = std::chrono::floor<std::chrono::days>(seconds);
+        std::chrono::hh_mm_ss clock{ seconds - day };
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%sT%02d:%02d:%02dZ",
+            FormatDate(static_cast<int>(day.time_since_epoch().count())).substr(0, 10).c_str(),
+            static_cast<int>(clock.hours().count()), static_cast<int>(clock.minutes().count()),
+            static_cast<int>(clock.seconds().count()));
+        return buffer;
+    }
+
+    static bool IsWeekend(int dayNumber) {
+        // 1970-01-01 was a Thursday
+        int weekday = ((dayNumber % 7) + 7 + 3) % 7;    // 0 = Monday
+        return weekday >= 5;
+    }
+
+    HrmsStubServer::HrmsStubServer(const StubServerConfig& config)
+        : m_Config(config) {
+        BuildData();
+    }
+
+    HrmsStubServer::~HrmsStubServer() {
+        Stop();
+    }
+
+    std::string HrmsStubServer::EmployeeJson(size_t id) const {
+        uint64_t h = Hash(m_Config.seed, id);
+        std::string first = Pick(s_FirstNames, h);
+        std::string last = Pick(s_LastNames, h >> 8);
+        std::string lowerFirst = first, lowerLast = last;
+        std::transform(lowerFirst.begin(), lowerFirst.end(), lowerFirst.begin(), ::tolower);
+        std::transform(lowerLast.begin(), lowerLast.end(), lowerLast.begin(), ::tolower);
+
+        size_t department = (h >> 16) % std::size(s_Departments);
+        int hireDay = m_Today - 30 - static_cast<int>((h >> 24) % 3650);
+        int birthDay = hireDay - 8000 - static_cast<int>((h >> 36) % 8000);
+        char code[16];
+        std::snprintf(code, sizeof(code), "EMP%04zu", id);
+
+        std::string json;
+        json.reserve(640 + m_Padding.size());
+        json += "{\"id\":" + std::to_string(id);
+        json += ",\"employeeCode\":\"" + std::string(code) + '"';
+        json += ",\"firstName\":\"" + first + "\",\"lastName\":\"" + last + '"';
+        json += ",\"fullName\":\"" + first + ' ' + last + '"';
+        json += ",\"email\":\"" + lowerFirst + '.' + lowerLast + std::to_string(id) + "@unicorn.example\"";
+        json += ",\"phoneNumber\":\"+1-555-" + std::to_string(1000 + id % 9000) + '"';
+        json += ",\"dateOfBirth\":\"" + FormatDate(birthDay) + '"';
+        json += ",\"hireDate\":\"" + FormatDate(hireDay) + '"';
+        json += ",\"position\":\"" + std::string(Pick(s_Positions, h >> 40)) + '"';
+        json += ",\"salary\":" + std::to_string(40000 + (h >> 44) % 80 * 1000);
+        json += std::string(",\"isActive\":") + ((h >> 52) % 20 != 0 ? "true" : "false");
+        json += ",\"departmentId\":" + std::to_string(department + 1);
+        json += ",\"departmentName\":\"" + std::string(s_Departments[department]) + '"';
+        if (id > 1) {
+            json += ",\"managerId\":" + std::to_string(1 + (h >> 20) % std::min<size_t>(id - 1, 10));
+        }
+        json += ",\"address\":\"" + std::to_string(1 + (h >> 28) % 200) + " Main Street" + m_Padding + '"';
+        json += ",\"city\":\"" + std::string(Pick(s_Cities, h >> 48)) + '"';
+        json += ",\"createdAt\":\"" + FormatDate(hireDay) + '"';
+        json += '}';
+        return json;
+    }
+
+    void HrmsStubServer::AppendAttendanceJson(std::string& out, size_t employeeId, int dayNumber) const {
+        uint64_t h = Hash(m_Config.seed ^ 0xA77E, (static_cast<uint64_t>(employeeId) << 32) | static_cast<uint32_t>(dayNumber));
+        uint64_t roll = h % 100;
+
+        uint64_t nameHash = Hash(m_Config.seed, employeeId);
+        std::string name = std::string(Pick(s_FirstNames, nameHash)) + ' ' + Pick(s_LastNames, nameHash >> 8);
+
+        out += "{\"id\":" + std::to_string(employeeId * 100000 + static_cast<size_t>(dayNumber) % 100000);
+        out += ",\"employeeId\":" + std::to_string(employeeId);
+        out += ",\"employeeName\":\"" + name + '"';
+        out += ",\"date\":\"" + FormatDate(dayNumber) + '"';
+
+        if (roll < 5) {
+            out += ",\"status\":\"Absent\"";
+        }
+        else {
+            int checkIn = 8 * 60 + 30 + static_cast<int>((h >> 8) % (roll < 15 ? 90 : 35));
+            int checkOut = checkIn + 7 * 60 + 30 + static_cast<int>((h >> 16) % 120);
+            double latitude = 38.7223 + static_cast<double>((h >> 24) % 1000) / 1e5;
+            double longitude = -9.1393 + static_cast<double>((h >> 34) % 1000) / 1e5;
+            bool valid = (h >> 44) % 50 != 0;
+
+            char gps[160];
+            std::snprintf(gps, sizeof(gps),
+                ",\"checkInLatitude\":%.5f,\"checkInLongitude\":%.5f,\"checkInAccuracy\":%d"
+                ",\"checkOutLatitude\":%.5f,\"checkOutLongitude\":%.5f",
+                latitude, longitude, static_cast<int>(5 + (h >> 50) % 30), latitude, longitude);
+
+            out += ",\"checkIn\":\"" + FormatTime(checkIn) + '"';
+            out += ",\"checkOut\":\"" + FormatTime(checkOut) + '"';
+            out += roll < 15 ? ",\"status\":\"Late\"" : ",\"status\":\"Present\"";
+            out += gps;
+            out += std::string(",\"isCheckInLocationValid\":") + (valid ? "true" : "false");
+            out += std::string(",\"isCheckOutLocationValid\":") + (valid ? "true" : "false");
+            out += ",\"workDuration\":\"" + FormatTime(checkOut - checkIn) + '"';
+        }
+
+        if (!m_Padding.empty()) {
+            out += ",\"notes\":\"" + m_Padding + '"';
+        }
+        out += '}';
+    }
+
+    void HrmsStubServer::BuildData() {
+        m_Today = static_cast<int>(std::chrono::floor<std::chrono::days>(
+            std::chrono::system_clock::now()).time_since_epoch().count());
+        m_Padding.assign(m_Config.paddingBytes, 'x');
+
+        m_Employees.clear();
+        m_Employees.reserve(m_Config.employeeCount);
+        std::string list = "[";
+        for (size_t id = 1; id <= m_Config.employeeCount; id++) {
+            m_Employees.push_back(EmployeeJson(id));
+            if (id > 1) list += ',';
+            list += m_Employees.back();
+        }
+        list += ']';
+        m_EmployeeList = Ok(list).body;
+
+        // Every tenth employee has a request waiting for approval
+        std::string pending = "[";
+        for (size_t id = 1; id <= m_Config.employeeCount; id += 10) {
+            uint64_t h = Hash(m_Config.seed ^ 0x1EAF, id);
+            uint64_t nameHash = Hash(m_Config.seed, id);
+            int start = m_Today + 3 + static_cast<int>(h % 40);
+            int days = 1 + static_cast<int>((h >> 8) % 10);
+
+            if (pending.size() > 1) pending += ',';
+            pending += "{\"id\":" + std::to_string(id);
+            pending += ",\"employeeId\":" + std::to_string(id);
+            pending += ",\"employeeName\":\"" + std::string(Pick(s_FirstNames, nameHash)) + ' ' +
+                Pick(s_LastNames, nameHash >> 8) + '"';
+            pending += ",\"startDate\":\"" + FormatDate(start) + '"';
+            pending += ",\"endDate\":\"" + FormatDate(start + days - 1) + '"';
+            pending += ",\"leaveType\":\"" + std::string(Pick(s_LeaveTypes, h >> 16)) + '"';
+            pending += ",\"reason\":\"Family matters" + m_Padding + '"';
+            pending += ",\"status\":\"Pending\"";
+            pending += ",\"totalDays\":" + std::to_string(days);
+            pending += ",\"createdAt\":\"" + FormatDate(m_Today - static_cast<int>((h >> 24) % 7)) + '"';
+            pending += '}';
+        }
+        pending += ']';
+        m_PendingLeave = Ok(pending).body;
+    }
+
+    // ============================================================================
+    // SERVER
+    // ============================================================================
+
+    bool HrmsStubServer::Start() {
+        if (m_Running) return true;
+
+#ifdef _WIN32
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+            std::cerr << "[HrmsStub] WSAStartup failed" << std::endl;
+            return false;
+        }
+#endif
+
+        SocketHandle listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (static_cast<intptr_t>(listener) < 0) {
+            std::cerr << "[HrmsStub] Failed to create socket" << std::endl;
+            return false;
+        }
+
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(m_Config.port);
+
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener, SOMAXCONN) != 0) {
+            std::cerr << "[HrmsStub] Cannot listen on port " << m_Config.port << std::endl;
+            CloseSocket(static_cast<intptr_t>(listener));
+            return false;
+        }
+
+        socklen_t length = sizeof(address);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+        m_Port = ntohs(address.sin_port);
+        m_Listener = static_cast<intptr_t>(listener);
+
+        m_Running = true;
+        m_AcceptThread = std::thread(&HrmsStubServer::AcceptLoop, this);
+        if (m_Config.eventsPerSecond > 0.0) {
+            m_EventThread = std::thread(&HrmsStubServer::EventLoop, this);
+        }
+        std::cout << "[HrmsStub] Listening on " << GetBaseUrl() << " (" << m_Config.employeeCount
+            << " employees, " << m_Config.latencyMs << "+" << m_Config.jitterMs << " ms)" << std::endl;
+        return true;
+    }
+
+    void HrmsStubServer::Stop() {
+        if (!m_Running.exchange(false)) return;
+
+        // Shutdown wakes the blocked accept()/recv() calls
+        {
+            std::lock_guard<std::mutex> lock(m_WorkersMutex);
+            m_WorkerFree.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_EventsMutex);
+            m_EventAdded.notify_all();
+        }
+        if (m_EventThread.joinable()) {
+            m_EventThread.join();
+        }
+        shutdown(static_cast<SocketHandle>(m_Listener), s_ShutdownBoth);
+        if (m_AcceptThread.joinable()) {
+            m_AcceptThread.join();
+        }
+        CloseSocket(m_Listener);
+        m_Listener = -1;
+
+        ReapConnections(true);
+
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    std::string HrmsStubServer::GetBaseUrl() const {
+        return "http://127.0.0.1:" + std::to_string(m_Port);
+    }
+
+    StubServerStats HrmsStubServer::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_StatsMutex);
+        return m_Stats;
+    }
+
+    void HrmsStubServer::AcceptLoop() {
+        while (m_Running) {
+            SocketHandle client = accept(static_cast<SocketHandle>(m_Listener), nullptr, nullptr);
+            if (static_cast<intptr_t>(client) < 0) {
+                if (!m_Running) break;
+                continue;
+            }
+
+            int noDelay = 1;
+            setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+            {
+                std::lock_guard<std::mutex> lock(m_StatsMutex);
+                m_Stats.connections++;
+            }
+
+            ReapConnections(false);
+
+            std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+            auto connection = std::make_unique<Connection>();
+            connection->socket = static_cast<intptr_t>(client);
+            Connection* raw = connection.get();
+            m_Connections.push_back(std::move(connection));
+            raw->thread = std::thread(&HrmsStubServer::Serve, this, std::ref(*raw));
+        }
+    }
+
+    void HrmsStubServer::ReapConnections(bool all) {
+        std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+        for (auto it = m_Connections.begin(); it != m_Connections.end();) {
+            Connection& connection = **it;
+            if (!all && !connection.done) {
+                ++it;
+                continue;
+            }
+
+            if (!connection.done) {
+                shutdown(static_cast<SocketHandle>(connection.socket), s_ShutdownBoth);
+            }
+            if (connection.thread.joinable()) {
+                connection.thread.join();
+            }
+            CloseSocket(connection.socket);
+            it = m_Connections.erase(it);
+        }
+    }
+
+    void HrmsStubServer::Serve(Connection& connection) {
+        SocketHandle socket = static_cast<SocketHandle>(connection.socket);
+        std::mt19937 random(m_Config.seed + m_NextConnection++);
+        std::string buffer;
+        char chunk[16384];
+
+        auto receive = [&]() {
+            int received = recv(socket, chunk, sizeof(chunk), 0);
+            if (received <= 0) return false;
+            buffer.append(chunk, static_cast<size_t>(received));
+            return true;
+        };
+
+        while (m_Running) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                if (buffer.size() > s_MaxHeaderBytes || !receive()) {
+                    connection.done = true;
+                    return;
+                }
+            }
+
+            HttpRequest request;
+            size_t lineEnd = buffer.find("\r\n");
+            std::string requestLine = buffer.substr(0, lineEnd);
+            size_t methodEnd = requestLine.find(' ');
+            size_t targetEnd = requestLine.find(' ', methodEnd + 1);
+            if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+                connection.done = true;
+                return;
+            }
+            request.method = requestLine.substr(0, methodEnd);
+            std::string target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+            size_t queryStart = target.find('?');
+            request.path = target.substr(0, queryStart);
+            request.query = queryStart == std::string::npos ? "" : target.substr(queryStart + 1);
+
+            size_t pos = lineEnd + 2;
+            while (pos < headerEnd) {
+                size_t end = buffer.find("\r\n", pos);
+                size_t colon = buffer.find(':', pos);
+                if (colon != std::string::npos && colon < end) {
+                    std::string name = buffer.substr(pos, colon - pos);
+                    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                    size_t valueStart = buffer.find_first_not_of(' ', colon + 1);
+                    request.headers[name] = buffer.substr(valueStart, end - valueStart);
+                }
+                pos = end + 2;
+            }
+
+            size_t contentLength = 0;
+            auto lengthHeader = request.headers.find("content-length");
+            if (lengthHeader != request.headers.end()) {
+                contentLength = std::strtoull(lengthHeader->second.c_str(), nullptr, 10);
+            }
+            if (contentLength > s_MaxBodyBytes) {
+                connection.done = true;
+                return;
+            }
+
+            size_t requestEnd = headerEnd + 4 + contentLength;
+            while (buffer.size() < requestEnd) {
+                if (!receive()) {
+                    connection.done = true;
+                    return;
+                }
+            }
+            request.body = buffer.substr(headerEnd + 4, contentLength);
+            buffer.erase(0, requestEnd);
+
+            auto connectionHeader = request.headers.find("connection");
+            bool keepAlive = connectionHeader == request.headers.end() || connectionHeader->second != "close";
+
+            if (m_Config.workers > 0) {
+                std::unique_lock<std::mutex> lock(m_WorkersMutex);
+                m_WorkerFree.wait(lock, [this]() { return m_BusyWorkers < m_Config.workers || !m_Running; });
+                m_BusyWorkers++;
+            }
+
+            int delay = m_Config.latencyMs;
+            if (m_Config.jitterMs > 0) {
+                delay += static_cast<int>(random() % static_cast<uint32_t>(m_Config.jitterMs + 1));
+            }
+            if (delay > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+            }
+
+            HttpResponse response = Handle(request, random());
+
+            if (m_Config.workers > 0) {
+                std::lock_guard<std::mutex> lock(m_WorkersMutex);
+                m_BusyWorkers--;
+                m_WorkerFree.notify_one();
+            }
+
+            // The connection stays with the stream until either side closes it
+            if (response.eventStream) {
+                ServeEvents(connection, request);
+                break;
+            }
+
+            static const char* reasons[] = { "OK", "Bad Request", "Unauthorized", "Not Found", "Service Unavailable" };
+            const char* reason = response.status == 200 ? reasons[0] : response.status == 400 ? reasons[1] :
+                response.status == 401 ? reasons[2] : response.status == 404 ? reasons[3] : reasons[4];
+
+            std::string head = "HTTP/1.1 " + std::to_string(response.status) + ' ' + reason + "\r\n";
+            head += "Content-Type: application/json; charset=utf-8\r\n";
+            head += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+            for (const auto& [name, value] : response.headers) {
+                head += name + ": " + value + "\r\n";
+            }
+            head += keepAlive ? "\r\n" : "Connection: close\r\n\r\n";
+
+            bool sent = SendAll(connection.socket, head.data(), head.size()) &&
+                (request.method == "HEAD" || SendAll(connection.socket, response.body.data(), response.body.size()));
+
+            {
+                std::lock_guard<std::mutex> lock(m_StatsMutex);
+                m_Stats.requests++;
+                m_Stats.bytesSent += head.size() + response.body.size();
+            }
+
+            if (!sent || !keepAlive) break;
+        }
+
+        connection.done = true;
+    }
+
+    // ============================================================================
+    // ROUTES
+    // ============================================================================
+
+    HrmsStubServer::HttpResponse HrmsStubServer::Ok(const std::string& dataJson, const char* message) {
+        HttpResponse response;
+        response.body = "{\"success\":true,\"message\":\"" + std::string(message) +
+            "\",\"data\":" + dataJson + ",\"errors\":[]}";
+        return response;
+    }
+
+    HrmsStubServer::HttpResponse HrmsStubServer::Failure(int status, const std::string& message) {
+        HttpResponse response;
+        response.status = status;
+        response.body = "{\"success\":false,\"message\":\"" + message + "\",\"errors\":[]}";
+        return response;
+    }
+
+    std::string HrmsStubServer::QueryValue(const std::string& query, const std::string& name) {
+        size_t pos = 0;
+        while (pos < query.size()) {
+            size_t end = query.find('&', pos);
+            if (end == std::string::npos) end = query.size();
+            size_t equals = query.find('=', pos);
+            if (equals != std::string::npos && equals < end && query.compare(pos, equals - pos, name) == 0) {
+                return query.substr(equals + 1, end - equals - 1);
+            }
+            pos = end + 1;
+        }
+        return {};
+    }
+
+    HrmsStubServer::HttpResponse HrmsStubServer::Handle(const HttpRequest& request, uint32_t random) {
+        const std::string& path = request.path;
+        if (path.rfind("/api/", 0) != 0) {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.notFound++;
+            return Failure(404, "Not found");
+        }
+
+        // Injected before auth and routing, like a flaky gateway: no
+        // Retry-After, since the server is not asking clients to back off
+        if (m_Config.errorRate > 0.0 && random < m_Config.errorRate * 4294967296.0) {
+            {
+                std::lock_guard<std::mutex> lock(m_StatsMutex);
+                m_Stats.errorsInjected++;
+            }
+            return Failure(503, "Service temporarily unavailable");
+        }
+
+        if (request.method == "POST" && path == "/api/auth/login") {
+            return HandleLogin(request);
+        }
+
+        // SSE clients often cannot set headers, so the stream takes the token
+        // in the query as well
+        auto auth = request.headers.find("authorization");
+        bool queryToken = path == "/api/events/stream" && QueryValue(request.query, "access_token").rfind("stub.", 0) == 0;
+        if (!queryToken && (auth == request.headers.end() || auth->second.rfind("Bearer stub.", 0) != 0)) {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.unauthorized++;
+            HttpResponse response = Failure(401, "Unauthorized");
+            response.headers.push_back({ "WWW-Authenticate", "Bearer" });
+            return response;
+        }
+
+        auto idAfter = [&](const std::string& prefix, size_t& id) {
+            if (path.size() <= prefix.size() || path.compare(0, prefix.size(), prefix) != 0) return false;
+            char* end = nullptr;
+            id = std::strtoull(path.c_str() + prefix.size(), &end, 10);
+            return *end == '\0';
+        };
+
+        if (request.method == "GET") {
+            size_t id = 0;
+            if (path == "/api/auth/me") {
+                return Ok(m_Employees.empty() ? "null" : m_Employees.front());
+            }
+            if (path == "/api/employees") {
+                HttpResponse response;
+                response.body = m_EmployeeList;
+                return response;
+            }
+            if (idAfter("/api/employees/", id) && id >= 1 && id <= m_Employees.size()) {
+                return Ok(m_Employees[id - 1]);
+            }
+            if (idAfter("/api/attendances/employee/", id) && id >= 1 && id <= m_Employees.size()) {
+                return HandleAttendanceForEmployee(id);
+            }
+            if (path == "/api/attendances/date-range") {
+                return HandleAttendanceRange(request.query);
+            }
+            if (path == "/api/leaverequests/pending") {
+                HttpResponse response;
+                response.body = m_PendingLeave;
+                return response;
+            }
+            if (path == "/api/events/stream") {
+                HttpResponse response;
+                response.eventStream = true;
+                return response;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_StatsMutex);
+        m_Stats.notFound++;
+        return Failure(404, "Not found");
+    }
+
+    HrmsStubServer::HttpResponse HrmsStubServer::HandleLogin(const HttpRequest& request) {
+        // Any user and any non-empty password signs in
+        if (request.body.find("\"password\"") == std::string::npos ||
+            request.body.find("\"password\":\"\"") != std::string::npos) {
+            return Failure(400, "Invalid username or password");
+        }
+
+        std::string token = "stub." + std::to_string(m_NextToken++);
+        std::string data = "{\"accessToken\":\"" + token + "\",\"refreshToken\":\"refresh." + token +
+            "\",\"expiresAt\":\"" + FormatDate(m_Today + 1) + "\",\"user\":{\"id\":1,\"username\":\"admin\"," +
+            "\"email\":\"admin@unicorn.example\",\"roles\":[\"Admin\"]}}";
+        return Ok(data, "Login successful");
+    }
+
+    HrmsStubServer::HttpResponse HrmsStubServer::HandleAttendanceForEmployee(size_t employeeId) const {
+        std::string data = "[";
+        for (int day = m_Today - 30; day < m_Today; day++) {
+            if (IsWeekend(day)) continue;
+            if (data.size() > 1) data += ',';
+            AppendAttendanceJson(data, employeeId, day);
+        }
+        data += ']';
+        return Ok(data);
+    }
+
+    HrmsStubServer::HttpResponse HrmsStubServer::HandleAttendanceRange(const std::string& query) const {
+        int first = m_Today - 7;
+        int last = m_Today - 1;
+        std::string start = QueryValue(query, "startDate");
+        std::string end = QueryValue(query, "endDate");
+        if ((!start.empty() && !ParseDate(start, first)) || (!end.empty() && !ParseDate(end, last)) || last < first) {
+            return Failure(400, "Invalid date range");
+        }
+
+        std::string data = "[";
+        size_t records = 0;
+        for (int day = first; day <= last && records < m_Config.maxRecords; day++) {
+            if (IsWeekend(day)) continue;
+            for (size_t id = 1; id <= m_Employees.size() && records < m_Config.maxRecords; id++) {
+                if (records++ > 0) data += ',';
+                AppendAttendanceJson(data, id, day);
+            }
+        }
+        data += ']';
+        return Ok(data);
+    }
+
+    // ============================================================================
+    // EVENT STREAM
+    // ============================================================================
+
+    HrmsStubServer::LiveEvent HrmsStubServer::MakeEvent(uint64_t id) const {
+        uint64_t h = Hash(m_Config.seed ^ 0xE7E7, id);
+        size_t employeeId = 1 + static_cast<size_t>(h % std::max<size_t>(m_Config.employeeCount, 1));
+        std::string now = FormatTimestamp(std::chrono::system_clock::now());
+
+        // Mostly clock-ins, as on a working morning
+        LiveEvent event;
+        event.id = id;
+        std::string data;
+        int kind = static_cast<int>((h >> 16) % 20);
+        if (kind < 12) {
+            event.type = "attendance.clocked-in";
+            data = "{\"employeeId\":" + std::to_string(employeeId) + ",\"recordId\":" + std::to_string(id) +
+                ",\"clockInTime\":\"" + now + "\",\"status\":\"" + ((h >> 24) % 5 == 0 ? "late" : "on-time") + "\"}";
+        }
+        else if (kind < 15) {
+            int start = m_Today + 3 + static_cast<int>((h >> 24) % 40);
+            int days = 1 + static_cast<int>((h >> 32) % 10);
+            event.type = "leave.requested";
+            data = "{\"requestId\":" + std::to_string(id) + ",\"employeeId\":" + std::to_string(employeeId) +
+                ",\"leaveType\":\"" + Pick(s_LeaveTypes, h >> 40) +
+                "\",\"startDate\":\"" + FormatDate(start).substr(0, 10) +
+                "\",\"endDate\":\"" + FormatDate(start + days - 1).substr(0, 10) +
+                "\",\"totalDays\":" + std::to_string(days) + ",\"status\":\"pending\"}";
+        }
+        else {
+            event.type = "employee.updated";
+            data = "{\"employeeId\":" + std::to_string(employeeId) +
+                ",\"changes\":{\"position\":\"" + Pick(s_Positions, h >> 24) + "\"}}";
+        }
+
+        event.data = "{\"event\":\"" + std::string(event.type) + "\",\"timestamp\":\"" + now +
+            "\",\"data\":" + data + ",\"metadata\":{\"version\":\"1.0\",\"source\":\"unicorn-hrms\"}}";
+        return event;
+    }
+
+    void HrmsStubServer::EventLoop() {
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / m_Config.eventsPerSecond));
+        auto next = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(m_EventsMutex);
+        while (m_Running) {
+            next += interval;
+            if (m_EventAdded.wait_until(lock, next, [this]() { return !m_Running; })) break;
+
+            m_Events.push_back(MakeEvent(++m_LastEventId));
+            if (m_Events.size() > s_EventHistory) m_Events.pop_front();
+            m_EventAdded.notify_all();
+        }
+    }
+
+    void HrmsStubServer::ServeEvents(Connection& connection, const HttpRequest& request) {
+        auto sendChunk = [&](const std::string& text) {
+            char size[16];
+            std::snprintf(size, sizeof(size), "%zx\r\n", text.size());
+            std::string chunk = size + text + "\r\n";
+            return SendAll(connection.socket, chunk.data(), chunk.size());
+        };
+
+        // Resume after Last-Event-ID if it is still in the history; an
+        // unknown or expired id gets only new events
+        uint64_t next;
+        {
+            std::lock_guard<std::mutex> lock(m_EventsMutex);
+            next = m_LastEventId + 1;
+            auto lastId = request.headers.find("last-event-id");
+            if (lastId != request.headers.end() && !lastId->second.empty()) {
+                uint64_t resume = std::strtoull(lastId->second.c_str(), nullptr, 10) + 1;
+                uint64_t oldest = m_Events.empty() ? next : m_Events.front().id;
+                if (resume >= oldest && resume <= next) next = resume;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.requests++;
+            m_Stats.eventStreams++;
+        }
+
+        std::string head = "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/event-stream\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Connection: close\r\n\r\n";     // Serve() does not read this connection again
+        if (!SendAll(connection.socket, head.data(), head.size()) || !sendChunk("retry: 1000\n: connected\n\n")) {
+            return;
+        }
+
+        size_t sent = 0;
+        while (m_Running && (m_Config.dropEvery == 0 || sent < m_Config.dropEvery)) {
+            std::string batch;
+            size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_EventsMutex);
+                bool ready = m_EventAdded.wait_for(lock, s_EventHeartbeat,
+                    [&]() { return !m_Running || m_LastEventId >= next; });
+                if (!m_Running) break;
+
+                if (!ready) {
+                    batch = ": keep-alive\n\n";     // Keeps proxies and idle timeouts from closing the stream
+                }
+                else {
+                    // A reader that fell behind the history skips ahead
+                    next = std::max(next, m_Events.front().id);
+                    for (size_t i = static_cast<size_t>(next - m_Events.front().id); i < m_Events.size(); i++) {
+                        if (m_Config.dropEvery > 0 && sent + count >= m_Config.dropEvery) break;
+                        const LiveEvent& event = m_Events[i];
+                        batch += "id: " + std::to_string(event.id) + "\nevent: " + event.type +
+                            "\ndata: " + event.data + "\n\n";
+                        count++;
+                    }
+                    next += count;
+                }
+            }
+
+            if (!sendChunk(batch)) return;
+            sent += count;
+
+            std::lock_guard<std::mutex> lock(m_StatsMutex);
+            m_Stats.eventsSent += count;
+            m_Stats.bytesSent += batch.size();
+        }
+
+        // Terminating chunk: a clean end of the response, the client reconnects
+        SendAll(connection.socket, "0\r\n\r\n", 5);
+    }
+
+} // namespace Unicorn::Tools
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <list>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace Unicorn::Tools {
+
+    struct StubServerConfig {
+        uint16_t port = 5080;               // 0 picks a free port
+        int latencyMs = 20;                 // Added to every response
+        int jitterMs = 10;                  // Uniform 0..jitterMs on top of the latency
+        double errorRate = 0.0;             // Fraction of API calls answered with 503
+        size_t workers = 0;                 // Requests worked on at once (0 = unlimited); the rest queue
+        size_t employeeCount = 200;
+        size_t paddingBytes = 0;            // Extra text in every record (address, notes, reason)
+        size_t maxRecords = 20000;          // Cap on date-range results
+        double eventsPerSecond = 2.0;       // Live HR events on /api/events/stream (0 = none)
+        size_t dropEvery = 0;               // Close each event stream after N events (0 = never)
+        uint32_t seed = 42;                 // Same seed, same data and error pattern
+    };
+
+    struct StubServerStats {
+        size_t connections = 0;
+        size_t requests = 0;
+        size_t errorsInjected = 0;
+        size_t unauthorized = 0;
+        size_t notFound = 0;
+        size_t bytesSent = 0;
+        size_t eventStreams = 0;
+        size_t eventsSent = 0;
+    };
+
+    // Stand-in for the HRMS API, for benchmarking the client without a
+    // backend. Serves the endpoints the desktop app calls with synthetic data
+    // shaped like the real DTOs (camelCase, ResponseDto envelope):
+    //
+    //   POST /api/auth/login                   -> access token for any user
+    //   GET  /api/auth/me
+    //   GET  /api/employees, /api/employees/{id}
+    //   GET  /api/attendances/employee/{id}    -> last 30 days
+    //   GET  /api/attendances/date-range?startDate=&endDate=
+    //   GET  /api/leaverequests/pending
+    //   GET  /api/events/stream                -> text/event-stream of webhook events
+    //
+    // Everything except login needs "Authorization: Bearer <token>" (the
+    // event stream also takes ?access_token=<token>). Plain
+    // HTTP/1.1 with keep-alive, one thread per connection; latency is a sleep
+    // on that thread, so concurrent requests overlap as they would against a
+    // real server. With 'workers' set, only that many are worked on at once
+    // and the rest wait their turn, like a backend at capacity.
+    //
+    // The event stream carries attendance.clocked-in, leave.requested and
+    // employee.updated in the webhook payload format, with sequential ids;
+    // a reconnect with Last-Event-ID replays what was missed while the id is
+    // still among the last s_EventHistory events. 'dropEvery' closes streams
+    // on purpose to exercise the client's resume.
+    class HrmsStubServer {
+    public:
+        explicit HrmsStubServer(const StubServerConfig& config = {});
+        ~HrmsStubServer();
+
+        HrmsStubServer(const HrmsStubServer&) = delete;
+        HrmsStubServer& operator=(const HrmsStubServer&) = delete;
+
+        // Binds 127.0.0.1 and starts accepting; false if the port is taken
+        bool Start();
+        void Stop();
+
+        bool IsRunning() const { return m_Running; }
+        uint16_t GetPort() const { return m_Port; }
+        std::string GetBaseUrl() const;
+        StubServerStats GetStats() const;
+
+    private:
+        struct HttpRequest {
+            std::string method;
+            std::string path;
+            std::string query;
+            std::unordered_map<std::string, std::string> headers;   // Lowercase names
+            std::string body;
+        };
+
+        struct HttpResponse {
+            int status = 200;
+            std::string body;
+            std::vector<std::pair<std::string, std::string>> headers;
+            bool eventStream = false;       // Serve() switches the connection to ServeEvents()
+        };
+
+        struct LiveEvent {
+            uint64_t id = 0;
+            const char* type = "";
+            std::string data;
+        };
+
+        struct Connection {
+            intptr_t socket = -1;
+            std::thread thread;
+            std::atomic<bool> done{ false };
+        };
+
+        void AcceptLoop();
+        void Serve(Connection& connection);
+        void ReapConnections(bool all);
+        void EventLoop();
+        void ServeEvents(Connection& connection, const HttpRequest& request);
+
+        HttpResponse Handle(const HttpRequest& request, uint32_t random);
+        HttpResponse HandleLogin(const HttpRequest& request);
+        HttpResponse HandleAttendanceForEmployee(size_t employeeId) const;
+        HttpResponse HandleAttendanceRange(const std::string& query) const;
+        LiveEvent MakeEvent(uint64_t id) const;
+
+        // Synthetic data, built once in the constructor
+        void BuildData();
+        std::string EmployeeJson(size_t id) const;
+        void AppendAttendanceJson(std::string& out, size_t employeeId, int dayNumber) const;
+
+        static HttpResponse Ok(const std::string& dataJson, const char* message = "Operation successful");
+        static HttpResponse Failure(int status, const std::string& message);
+        static std::string QueryValue(const std::string& query, const std::string& name);
+
+        StubServerConfig m_Config;
+        uint16_t m_Port = 0;
+        intptr_t m_Listener = -1;
+        std::atomic<bool> m_Running{ false };
+        std::thread m_AcceptThread;
+
+        std::mutex m_ConnectionsMutex;
+        std::list<std::unique_ptr<Connection>> m_Connections;
+
+        std::mutex m_WorkersMutex;
+        std::condition_variable m_WorkerFree;
+        size_t m_BusyWorkers = 0;
+
+        std::vector<std::string> m_Employees;       // Index = id - 1
+        std::string m_EmployeeList;                 // Whole /api/employees response
+        std::string m_PendingLeave;
+        std::string m_Padding;
+        int m_Today = 0;                            // Days since 1970-01-01
+
+        std::thread m_EventThread;
+        std::mutex m_EventsMutex;
+        std::condition_variable m_EventAdded;
+        std::deque<LiveEvent> m_Events;             // The last s_EventHistory, oldest first
+        uint64_t m_LastEventId = 0;
+        static constexpr size_t s_EventHistory = 1024;
+
+        mutable std::mutex m_StatsMutex;
+        StubServerStats m_Stats;
+        std::atomic<uint32_t> m_NextConnection{ 0 };
+        std::atomic<uint32_t> m_NextToken{ 1 };
+    };
+
+} // namespace Unicorn::Tools
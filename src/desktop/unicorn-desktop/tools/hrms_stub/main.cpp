@@ -0,0 +1,85 @@
+#include "hrms_stub_server.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <csignal>
+#include <thread>
+#include <chrono>
+
+// Standalone HRMS stand-in: point the desktop app (or anything else) at
+// http://127.0.0.1:<port>/api and stop it with Ctrl+C.
+
+static volatile std::sig_atomic_t s_Stop = 0;
+
+static void OnSignal(int) {
+    s_Stop = 1;
+}
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: HrmsStubServer [options]\n"
+        "  --port N          Port on 127.0.0.1 (default 5080, 0 = any free port)\n"
+        "  --latency MS      Delay before every response (default 20)\n"
+        "  --jitter MS       Extra uniform delay, 0..MS (default 10)\n"
+        "  --error-rate F    Fraction of API calls answered with 503 (default 0)\n"
+        "  --workers N       Requests worked on at once, the rest queue (default 0 = unlimited)\n"
+        "  --employees N     Size of the synthetic company (default 200)\n"
+        "  --padding N       Extra bytes of text in every record (default 0)\n"
+        "  --seed N          Data and error pattern seed (default 42)\n"
+        "  --event-rate F    Live events per second on /api/events/stream (default 2)\n"
+        "  --drop-every N    Close event streams after N events (default 0 = never)\n";
+}
+
+int main(int argc, char** argv) {
+    Unicorn::Tools::StubServerConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return 0;
+        }
+        if (!value) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+
+        if (arg == "--port") config.port = static_cast<uint16_t>(std::atoi(value));
+        else if (arg == "--latency") config.latencyMs = std::atoi(value);
+        else if (arg == "--jitter") config.jitterMs = std::atoi(value);
+        else if (arg == "--error-rate") config.errorRate = std::atof(value);
+        else if (arg == "--workers") config.workers = std::strtoull(value, nullptr, 10);
+        else if (arg == "--employees") config.employeeCount = std::strtoull(value, nullptr, 10);
+        else if (arg == "--padding") config.paddingBytes = std::strtoull(value, nullptr, 10);
+        else if (arg == "--event-rate") config.eventsPerSecond = std::atof(value);
+        else if (arg == "--drop-every") config.dropEvery = std::strtoull(value, nullptr, 10);
+        else if (arg == "--seed") config.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            PrintUsage();
+            return 1;
+        }
+        i++;
+    }
+
+    Unicorn::Tools::HrmsStubServer server(config);
+    if (!server.Start()) {
+        return 1;
+    }
+
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    while (!s_Stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    server.Stop();
+    auto stats = server.GetStats();
+    std::cout << "[HrmsStub] Served " << stats.requests << " requests on " << stats.connections
+        << " connections (" << stats.errorsInjected << " injected errors, "
+        << stats.unauthorized << " unauthorized), " << stats.eventsSent << " events on "
+        << stats.eventStreams << " streams" << std::endl;
+    return 0;
+}
@@ -0,0 +1,360 @@
+#include "hrms_stub/hrms_stub_server.h"
+#include "background/background_manager.h"
+#include "background/latency_histogram.h"
+#include "core/application.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+// Drives BackgroundManager against the HRMS stand-in (in-process by default,
+// or any server given with --url) with a mix of the app's API calls, at a
+// series of fixed concurrency limits and then with the adaptive limiter, and
+// prints throughput and latency percentiles per run. With --watch it instead
+// holds the live event stream open and checks that no event is lost or
+// repeated across reconnects.
+
+// Headless: there is no window whose event loop needs waking, the run loop
+// below pumps BackgroundManager::Update() itself
+namespace Unicorn {
+    void Application::WakeMainLoop() {}
+    void Application::TriggerRender() {}
+}
+
+using namespace Unicorn;
+
+struct LoadOptions {
+    std::string url;                    // Empty: start the in-process stand-in
+    size_t requests = 2000;             // Per concurrency level
+    std::vector<size_t> levels = { 1, 4, 16, 64 };
+    size_t adaptiveClients = 64;        // Offered load for the adaptive run; 0 skips it
+    int retries = 0;
+    int watchSeconds = 0;               // > 0: subscribe to the event stream instead
+    Tools::StubServerConfig server;
+};
+
+struct Endpoint {
+    const char* path;
+    int weight;
+    bool perEmployee;                   // Path ends with an employee id
+};
+
+// Roughly what the desktop app sends while someone works in it
+static const Endpoint s_Mix[] = {
+    { "/api/attendances/employee/", 40, true },
+    { "/api/employees/", 30, true },
+    { "/api/leaverequests/pending", 10, false },
+    { "/api/attendances/date-range?startDate=", 10, false },
+    { "/api/employees", 5, false },
+    { "/api/auth/me", 5, false },
+};
+
+static std::vector<size_t> ParseLevels(const std::string& text) {
+    std::vector<size_t> levels;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        size_t level = std::strtoull(text.substr(pos, end - pos).c_str(), nullptr, 10);
+        if (level > 0) levels.push_back(level);
+        pos = end + 1;
+    }
+    return levels;
+}
+
+static std::string DateDaysAgo(int days) {
+    auto day = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()) - std::chrono::days{ days };
+    std::chrono::year_month_day date{ day };
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u",
+        static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+    return buffer;
+}
+
+// Runs the UI side of the client until 'done' holds
+template<typename Done>
+static void Pump(Background::BackgroundManager& manager, Done&& done) {
+    while (!done()) {
+        manager.Update();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+static std::string Login(Background::BackgroundManager& manager, const std::string& baseUrl) {
+    Background::RequestOptions options;
+    options.method = Background::RequestMethod::POST;
+    options.url = baseUrl + "/api/auth/login";
+    options.body = R"({"usernameOrEmail":"admin","password":"admin"})";
+    options.headers["Content-Type"] = "application/json";
+
+    bool finished = false;
+    std::string token;
+    manager.Request(options, [&](Background::RequestState state, const Background::Response& response) {
+        if (state == Background::RequestState::Idle || state == Background::RequestState::Loading) return;
+        finished = true;
+
+        std::string_view body = response.body.View();
+        const std::string_view key = "\"accessToken\":\"";
+        size_t start = body.find(key);
+        if (state == Background::RequestState::Success && start != std::string_view::npos) {
+            start += key.size();
+            token = std::string(body.substr(start, body.find('"', start) - start));
+        }
+        else {
+            std::cerr << "[LoadGen] Login failed: " << response.error << std::endl;
+        }
+        });
+
+    Pump(manager, [&]() { return finished; });
+    return token;
+}
+
+// 'concurrency' callers keep one request outstanding each; with 'adaptive'
+// the client's limiter decides how many of them reach the server at once
+static void RunLevel(Background::BackgroundManager& manager, const LoadOptions& options,
+    const std::string& baseUrl, const std::string& token, size_t employees, size_t concurrency, bool adaptive) {
+    manager.SetMaxConnectionsPerHost(concurrency);
+    manager.SetAdaptiveConcurrency(adaptive);
+    if (adaptive) {
+        manager.SetConcurrencyLimit(4, 1, concurrency);
+    }
+    else {
+        manager.SetConcurrencyLimit(concurrency, concurrency, concurrency);
+    }
+
+    std::vector<int> weights;
+    for (const auto& endpoint : s_Mix) weights.push_back(endpoint.weight);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    std::mt19937 random(static_cast<uint32_t>(concurrency));
+    const std::string range = DateDaysAgo(7) + "&endDate=" + DateDaysAgo(1);
+
+    Background::LatencyHistogram latency;
+    Background::RequestStats before = manager.GetStats();
+    size_t issued = 0, completed = 0, failed = 0;
+    size_t bytes = 0;
+
+    std::function<void()> issue = [&]() {
+        const Endpoint& endpoint = s_Mix[pick(random)];
+        Background::RequestOptions request;
+        request.url = baseUrl + endpoint.path;
+        if (endpoint.perEmployee) {
+            request.url += std::to_string(1 + random() % employees);
+        }
+        else if (request.url.back() == '=') {
+            request.url += range;
+        }
+        // Distinct URLs, so concurrent identical GETs are not coalesced
+        request.url += (request.url.find('?') == std::string::npos ? "?n=" : "&n=") + std::to_string(issued);
+        request.headers["Authorization"] = "Bearer " + token;
+        request.retryCount = options.retries;
+        issued++;
+
+        manager.Request(request, [&](Background::RequestState state, const Background::Response& response) {
+            if (state == Background::RequestState::Idle || state == Background::RequestState::Loading) return;
+
+            completed++;
+            if (state == Background::RequestState::Success) {
+                latency.Record(response.elapsedTime);
+                bytes += response.downloadSize;
+            }
+            else {
+                failed++;
+            }
+
+            // Closed loop: every finished request makes room for the next
+            if (issued < options.requests) issue();
+            });
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < concurrency && issued < options.requests; i++) {
+        issue();
+    }
+    Pump(manager, [&]() { return completed >= options.requests; });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Background::RequestStats after = manager.GetStats();
+    auto ms = [](double value) { return value * 1000.0; };
+    std::string label = adaptive ? "adaptive" : std::to_string(concurrency);
+    std::printf("%11s %9zu %7zu %9.1f %8.1f %8.1f %8.1f %8.1f %9.2f %6zu %7zu\n",
+        label.c_str(), completed, failed, completed / seconds,
+        ms(latency.Percentile(50.0)), ms(latency.Percentile(95.0)), ms(latency.Percentile(99.0)),
+        ms(latency.Max()), bytes / seconds / (1024.0 * 1024.0),
+        after.newConnections - before.newConnections, after.retries - before.retries);
+
+    if (adaptive) {
+        static const char* decisions[] = { "hold", "increase", "decrease (latency)", "decrease (errors)" };
+        for (const auto& host : manager.GetConcurrencyLimits()) {
+            std::printf("%11s limit %zu of %zu callers, baseline %.1f ms, last window %.1f ms, "
+                "%zu increases, %zu latency / %zu error decreases, last: %s\n",
+                "", host.limit, concurrency, host.baselineLatency * 1000.0, host.recentLatency * 1000.0,
+                host.increases, host.latencyDecreases, host.errorDecreases,
+                decisions[static_cast<int>(host.lastDecision)]);
+        }
+    }
+}
+
+// The stand-in numbers its events 1, 2, 3...; after a drop the client resumes
+// with Last-Event-ID, so the ids seen must still run without gaps or repeats
+static bool WatchEvents(Background::BackgroundManager& manager, const std::string& baseUrl,
+    const std::string& token, int seconds) {
+    Background::SubscriptionOptions options;
+    options.url = baseUrl + "/api/events/stream";
+    options.headers["Authorization"] = "Bearer " + token;
+
+    std::unordered_map<std::string, size_t> types;
+    uint64_t firstId = 0, lastId = 0;
+    size_t events = 0, gaps = 0, repeats = 0, opened = 0;
+    bool closed = false;
+
+    Background::RequestStats before = manager.GetStats();
+    size_t id = manager.Subscribe(options,
+        [&](const Background::ServerEvent& event) {
+            uint64_t eventId = std::strtoull(event.id.c_str(), nullptr, 10);
+            if (events > 0 && eventId <= lastId) repeats++;
+            else if (events > 0 && eventId != lastId + 1) gaps += eventId - lastId - 1;
+            if (events == 0) firstId = eventId;
+            lastId = std::max(lastId, eventId);
+            types[event.type]++;
+            events++;
+        },
+        [&](Background::SubscriptionState state, const std::string& error) {
+            if (state == Background::SubscriptionState::Open) opened++;
+            if (state == Background::SubscriptionState::Closed) {
+                std::cerr << "[LoadGen] Event stream closed: " << error << std::endl;
+                closed = true;
+            }
+        });
+
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    Pump(manager, [&]() { return closed || std::chrono::steady_clock::now() >= end; });
+    std::string resumeFrom = manager.GetLastEventId(id);
+    manager.Unsubscribe(id);
+
+    Background::RequestStats after = manager.GetStats();
+    std::printf("\n[LoadGen] %zu events (ids %llu..%llu) over %zu connections, %zu reconnects, "
+        "%zu missing, %zu repeated; resume from \"%s\"\n",
+        events, static_cast<unsigned long long>(firstId), static_cast<unsigned long long>(lastId), opened,
+        after.subscriptionReconnects - before.subscriptionReconnects, gaps, repeats, resumeFrom.c_str());
+    for (const auto& [type, count] : types) {
+        std::printf("%11s %-24s %zu\n", "", type.c_str(), count);
+    }
+    return !closed && events > 0 && gaps == 0 && repeats == 0;
+}
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: NetworkLoadGen [options]\n"
+        "  --url URL         Server to load (default: in-process HRMS stand-in)\n"
+        "  --requests N      Requests per concurrency level (default 2000)\n"
+        "  --levels A,B,...  Fixed concurrency limits (default 1,4,16,64)\n"
+        "  --adaptive N      Callers for the adaptive-limit run (default 64, 0 = skip)\n"
+        "  --retries N       Retry count for every request (default 0)\n"
+        "  --watch SECONDS   Follow /api/events/stream instead and check event ids\n"
+        "In-process stand-in:\n"
+        "  --latency MS      Server delay per response (default 20)\n"
+        "  --jitter MS       Extra uniform delay, 0..MS (default 10)\n"
+        "  --error-rate F    Fraction answered with 503 (default 0)\n"
+        "  --workers N       Requests the server works on at once (default 0 = unlimited)\n"
+        "  --employees N     Synthetic employees (default 200)\n"
+        "  --padding N       Extra bytes of text per record (default 0)\n"
+        "  --event-rate F    Live events per second (default 2)\n"
+        "  --drop-every N    Close event streams after N events (default 0 = never)\n";
+}
+
+int main(int argc, char** argv) {
+    LoadOptions options;
+    options.server.port = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return 0;
+        }
+        if (!value) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+
+        if (arg == "--url") options.url = value;
+        else if (arg == "--requests") options.requests = std::strtoull(value, nullptr, 10);
+        else if (arg == "--levels") options.levels = ParseLevels(value);
+        else if (arg == "--adaptive") options.adaptiveClients = std::strtoull(value, nullptr, 10);
+        else if (arg == "--retries") options.retries = std::atoi(value);
+        else if (arg == "--watch") options.watchSeconds = std::atoi(value);
+        else if (arg == "--latency") options.server.latencyMs = std::atoi(value);
+        else if (arg == "--jitter") options.server.jitterMs = std::atoi(value);
+        else if (arg == "--error-rate") options.server.errorRate = std::atof(value);
+        else if (arg == "--workers") options.server.workers = std::strtoull(value, nullptr, 10);
+        else if (arg == "--employees") options.server.employeeCount = std::strtoull(value, nullptr, 10);
+        else if (arg == "--padding") options.server.paddingBytes = std::strtoull(value, nullptr, 10);
+        else if (arg == "--event-rate") options.server.eventsPerSecond = std::atof(value);
+        else if (arg == "--drop-every") options.server.dropEvery = std::strtoull(value, nullptr, 10);
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            PrintUsage();
+            return 1;
+        }
+        i++;
+    }
+
+    if (options.requests == 0 || (options.levels.empty() && options.adaptiveClients == 0) ||
+        options.server.employeeCount == 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::unique_ptr<Tools::HrmsStubServer> server;
+    std::string baseUrl = options.url;
+    if (baseUrl.empty()) {
+        server = std::make_unique<Tools::HrmsStubServer>(options.server);
+        if (!server->Start()) return 1;
+        baseUrl = server->GetBaseUrl();
+    }
+    while (!baseUrl.empty() && baseUrl.back() == '/') baseUrl.pop_back();
+
+    auto& manager = Background::BackgroundManager::Get();
+    manager.Init();
+
+    int status = 0;
+    std::string token = Login(manager, baseUrl);
+    if (token.empty()) {
+        status = 1;
+    }
+    else if (options.watchSeconds > 0) {
+        status = WatchEvents(manager, baseUrl, token, options.watchSeconds) ? 0 : 1;
+    }
+    else {
+        std::printf("\n%11s %9s %7s %9s %8s %8s %8s %8s %9s %6s %7s\n",
+            "concurrency", "requests", "errors", "req/s", "p50 ms", "p95 ms", "p99 ms", "max ms",
+            "MB/s", "conns", "retries");
+        for (size_t level : options.levels) {
+            RunLevel(manager, options, baseUrl, token, options.server.employeeCount, level, false);
+        }
+        if (options.adaptiveClients > 0) {
+            RunLevel(manager, options, baseUrl, token, options.server.employeeCount, options.adaptiveClients, true);
+        }
+    }
+
+    manager.Shutdown();
+
+    if (server) {
+        server->Stop();
+        auto stats = server->GetStats();
+        std::cout << "\n[LoadGen] Server: " << stats.requests << " requests, " << stats.connections
+            << " connections, " << stats.errorsInjected << " injected errors, " << stats.eventsSent
+            << " events on " << stats.eventStreams << " streams" << std::endl;
+    }
+    return status;
+}